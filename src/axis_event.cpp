@@ -39,19 +39,32 @@ AxisEvent::AxisEvent(AxisEventHandler* handler) :
 void
 AxisEvent::add_filter(AxisFilterPtr filter)
 {
-  m_filters.push_back(filter);
+  m_filters.add(filter);
 }
 
 void
 AxisEvent::send(int value, int min, int max)
 {
   m_last_raw_value = value;
+  m_last_min = min;
+  m_last_max = max;
 
-  for(std::vector<AxisFilterPtr>::const_iterator i = m_filters.begin(); i != m_filters.end(); ++i)
-  {
-    value = (*i)->filter(value, min, max);
-  }
+  send_filtered(m_filters.filter(value, min, max), min, max);
+}
+
+void
+AxisEvent::send_prefiltered(int raw_value, int value, int min, int max)
+{
+  m_last_raw_value = raw_value;
+  m_last_min = min;
+  m_last_max = max;
+
+  send_filtered(m_filters.filter_tail(value, min, max), min, max);
+}
 
+void
+AxisEvent::send_filtered(int value, int min, int max)
+{
   if (m_last_send_value != value)
   {
     m_last_send_value = value;
@@ -60,18 +73,21 @@ AxisEvent::send(int value, int min, int max)
 }
 
 void
-AxisEvent::update(int msec_delta)
+AxisEvent::update(int usec_delta)
 {
-  for(std::vector<AxisFilterPtr>::const_iterator i = m_filters.begin(); i != m_filters.end(); ++i)
-  {
-    (*i)->update(msec_delta);
-  }
+  m_filters.update(usec_delta);
 
-  m_handler->update(msec_delta);
+  m_handler->update(usec_delta);
 
   send(m_last_raw_value, m_last_min, m_last_max);
 }
 
+int
+AxisEvent::get_next_update() const
+{
+  return earliest_update(m_handler->get_next_update(), m_filters.get_next_update());
+}
+
 std::string
 AxisEvent::str() const
 {
@@ -21,7 +21,7 @@
 
 #include <boost/scoped_ptr.hpp>
 
-#include "axis_filter.hpp"
+#include "axis_filter_chain.hpp"
 #include "ui_event.hpp"
 
 class AxisEvent;
@@ -38,17 +38,33 @@ public:
   void add_filter(AxisFilterPtr filter);
 
   void send(int value, int min, int max);
-  void update(int msec_delta);
+
+  /** Shares the baked filter tables with other events, see
+      AxisFilterChain::set_table_cache() */
+  void set_table_cache(AxisTableCachePtr tables) { m_filters.set_table_cache(tables); }
+
+  /** Returns the offset of the lookup table for the leading stateless
+      filters, see AxisFilterChain::get_lookup_offset() */
+  int get_lookup_offset(int min, int max) { return m_filters.get_lookup_offset(min, max); }
+
+  /** Like send(), but \a value is \a raw_value already looked up in
+      the table from get_lookup_offset() */
+  void send_prefiltered(int raw_value, int value, int min, int max);
+  void update(int usec_delta);
+  int get_next_update() const;
 
   std::string str() const;
 
+private:
+  void send_filtered(int value, int min, int max);
+
 private:
   int  m_last_raw_value;
   int  m_last_send_value;
   int  m_last_min;
   int  m_last_max;
   boost::scoped_ptr<AxisEventHandler> m_handler;
-  std::vector<AxisFilterPtr> m_filters;
+  AxisFilterChain m_filters;
 };
 
 class AxisEventHandler
@@ -58,7 +74,11 @@ public:
   virtual ~AxisEventHandler() {}
 
   virtual void send(int value, int min, int max) =0;
-  virtual void update(int msec_delta) =0;
+  virtual void update(int usec_delta) =0;
+  /** Returns the msec until update() has to be called again, 0 for
+      the next tick or -1 when there is no time dependent state and
+      update() would not change anything */
+  virtual int get_next_update() const { return -1; }
 
   virtual std::string str() const =0;
 };
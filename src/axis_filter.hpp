@@ -36,7 +36,15 @@ public:
   AxisFilter() {}
   virtual ~AxisFilter() {}
 
-  virtual void update(int msec_delta) {}
+  virtual void update(int usec_delta) {}
+  /** Returns the msec until update() has to be called again, 0 for
+      the next tick or -1 when there is no time dependent state and
+      update() would not change anything */
+  virtual int get_next_update() const { return -1; }
+  /** Returns true if filter() depends on nothing but its arguments,
+      such filters can be baked into a lookup table by
+      AxisFilterChain */
+  virtual bool is_stateless() const { return false; }
   virtual int filter(int value, int min, int max) = 0;
   virtual std::string str() const = 0;
 };
@@ -0,0 +1,194 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "axis_filter_chain.hpp"
+
+#include <stdint.h>
+
+#include "helper.hpp"
+
+AxisFilterChain::AxisFilterChain() :
+  m_filters(),
+  m_stages(),
+  m_tables(new AxisTableCache)
+{
+}
+
+void
+AxisFilterChain::add(AxisFilterPtr filter)
+{
+  const bool stateless = filter->is_stateless();
+
+  if (stateless && !m_stages.empty() && m_stages.back().stateless)
+  {
+    // extend the current run, tables baked so far no longer apply
+    m_stages.back().end += 1;
+    m_stages.back().key += "," + filter->str();
+    m_stages.back().tables.clear();
+  }
+  else
+  {
+    Stage stage;
+    stage.begin     = static_cast<int>(m_filters.size());
+    stage.end       = stage.begin + 1;
+    stage.stateless = stateless;
+    stage.key       = filter->str();
+    m_stages.push_back(stage);
+  }
+
+  m_filters.push_back(filter);
+}
+
+int
+AxisFilterChain::filter_stage(const Stage& stage, int value, int min, int max)
+{
+  for(int i = stage.begin; i < stage.end; ++i)
+  {
+    value = m_filters[i]->filter(value, min, max);
+  }
+  return value;
+}
+
+void
+AxisFilterChain::set_table_cache(AxisTableCachePtr tables)
+{
+  m_tables = tables;
+
+  // the offsets point into the old cache
+  for(std::vector<Stage>::iterator stage = m_stages.begin(); stage != m_stages.end(); ++stage)
+  {
+    stage->tables.clear();
+  }
+}
+
+int
+AxisFilterChain::get_table(Stage& stage, int min, int max)
+{
+  for(std::vector<Table>::const_iterator i = stage.tables.begin(); i != stage.tables.end(); ++i)
+  {
+    if (i->min == min && i->max == max)
+    {
+      return i->offset;
+    }
+  }
+
+  if (min > max ||
+      static_cast<int64_t>(max) - min >= kMaxTableSize ||
+      static_cast<int>(stage.tables.size()) >= kMaxTables)
+  {
+    return -1;
+  }
+  else
+  {
+    Table table;
+    table.min = min;
+    table.max = max;
+    table.offset = m_tables->find(stage.key, min, max);
+    if (table.offset < 0)
+    {
+      table.offset = m_tables->insert(stage.key, min, max);
+      int* values = m_tables->data() + table.offset;
+      for(int value = min; value <= max; ++value)
+      {
+        values[value - min] = filter_stage(stage, value, min, max);
+      }
+    }
+    stage.tables.push_back(table);
+    return table.offset;
+  }
+}
+
+int
+AxisFilterChain::filter(int value, int min, int max)
+{
+  return filter_stages(m_stages.begin(), value, min, max);
+}
+
+int
+AxisFilterChain::get_lookup_offset(int min, int max)
+{
+  if (m_stages.empty() || !m_stages.front().stateless)
+  {
+    return -1;
+  }
+  else
+  {
+    return get_table(m_stages.front(), min, max);
+  }
+}
+
+int
+AxisFilterChain::filter_tail(int value, int min, int max)
+{
+  if (m_stages.empty())
+  {
+    return value;
+  }
+  else
+  {
+    return filter_stages(m_stages.begin() + 1, value, min, max);
+  }
+}
+
+int
+AxisFilterChain::filter_stages(std::vector<Stage>::iterator first, int value, int min, int max)
+{
+  for(std::vector<Stage>::iterator stage = first; stage != m_stages.end(); ++stage)
+  {
+    int offset = -1;
+    if (stage->stateless)
+    {
+      offset = get_table(*stage, min, max);
+    }
+
+    // values outside of the range, e.g. produced by a previous
+    // filter, fall back to calling the filters directly
+    if (offset >= 0 && min <= value && value <= max)
+    {
+      value = m_tables->data()[offset + value - min];
+    }
+    else
+    {
+      value = filter_stage(*stage, value, min, max);
+    }
+  }
+  return value;
+}
+
+void
+AxisFilterChain::update(int usec_delta)
+{
+  for(std::vector<AxisFilterPtr>::const_iterator i = m_filters.begin(); i != m_filters.end(); ++i)
+  {
+    (*i)->update(usec_delta);
+  }
+}
+
+int
+AxisFilterChain::get_next_update() const
+{
+  int next = -1;
+  for(std::vector<AxisFilterPtr>::const_iterator i = m_filters.begin(); i != m_filters.end(); ++i)
+  {
+    next = earliest_update(next, (*i)->get_next_update());
+  }
+  return next;
+}
+
+/* EOF */
@@ -0,0 +1,110 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_AXIS_FILTER_CHAIN_HPP
+#define HEADER_XBOXDRV_AXIS_FILTER_CHAIN_HPP
+
+#include <vector>
+
+#include "axis_filter.hpp"
+#include "axis_table_cache.hpp"
+
+/** A list of AxisFilters that are applied one after the other. Runs
+    of stateless filters get baked into an integer lookup table the
+    first time a (min, max) range is seen, so that filtering them
+    boils down to a single table load, stateful filters are called
+    as usual. The tables are kept in an AxisTableCache, which can be
+    shared with other chains. */
+class AxisFilterChain
+{
+private:
+  /** ranges larger than this are never baked */
+  static const int kMaxTableSize = 65536;
+
+  /** number of distinct ranges a stage keeps tables for, axis
+      normally only ever use a single one */
+  static const int kMaxTables = 4;
+
+  struct Table
+  {
+    int min;
+    int max;
+    int offset;
+
+    Table() : min(), max(), offset() {}
+  };
+
+  /** a run of filters, [begin, end) in m_filters */
+  struct Stage
+  {
+    int begin;
+    int end;
+    bool stateless;
+
+    /** the str() of the filters in the stage, used to find tables
+        baked by other chains */
+    std::string key;
+    std::vector<Table> tables;
+
+    Stage() : begin(), end(), stateless(), key(), tables() {}
+  };
+
+  std::vector<AxisFilterPtr> m_filters;
+  std::vector<Stage> m_stages;
+  AxisTableCachePtr m_tables;
+
+public:
+  AxisFilterChain();
+
+  void add(AxisFilterPtr filter);
+
+  int filter(int value, int min, int max);
+
+  /** Replaces the cache the tables are baked into, chains that share
+      a cache share the tables of equal filter runs */
+  void set_table_cache(AxisTableCachePtr tables);
+  const AxisTableCachePtr& get_table_cache() const { return m_tables; }
+
+  /** Returns the offset into get_table_cache() of the table the
+      leading run of stateless filters is baked into for the given
+      range, indexed by value - min, or -1 if the chain doesn't start
+      with such a run or it can't be baked */
+  int get_lookup_offset(int min, int max);
+
+  /** Like filter(), but skips the leading run of stateless filters,
+      \a value has to be looked up in get_lookup_offset() already */
+  int filter_tail(int value, int min, int max);
+  void update(int usec_delta);
+  int get_next_update() const;
+
+  bool empty() const { return m_filters.empty(); }
+
+  typedef std::vector<AxisFilterPtr>::const_iterator const_iterator;
+  const_iterator begin() const { return m_filters.begin(); }
+  const_iterator end() const { return m_filters.end(); }
+
+private:
+  int filter_stages(std::vector<Stage>::iterator first, int value, int min, int max);
+  int filter_stage(const Stage& stage, int value, int min, int max);
+  int get_table(Stage& stage, int min, int max);
+};
+
+#endif
+
+/* EOF */
@@ -19,12 +19,22 @@
 #include "axis_map.hpp"
 
 #include "axis_event_factory.hpp"
+#include "controller_message.hpp"
 #include "controller_message_descriptor.hpp"
+#include "helper.hpp"
 #include "log.hpp"
+#include "table_gather.hpp"
 
 AxisMap::AxisMap(const AxisMapOptions& opts, UInput& uinput, int slot, bool extra_devices) :
   m_mappings(),
-  m_map()
+  m_map(),
+  m_tables(new AxisTableCache),
+  m_batch_event(),
+  m_batch_offset(),
+  m_batch_raw(),
+  m_batch_value(),
+  m_batch_min(),
+  m_batch_max()
 {
   AxisEventFactory factory(uinput, slot, extra_devices);
 
@@ -40,6 +50,7 @@ AxisMap::AxisMap(const AxisMapOptions& opts, UInput& uinput, int slot, bool extr
     {
       event->add_filter(AxisFilter::from_string(*j));
     }
+    event->set_table_cache(m_tables);
 
     // event is usable at this point, but can't yet store it in its
     // final place, as the axis strings can't be resolved yet
@@ -63,6 +74,15 @@ AxisMap::init(const ControllerMessageDescriptor& desc)
     {
       int abs = desc.abs().get(it->axis);
       m_map.at(abs).add(ButtonCombination(it->buttons), it->event);
+
+      // bake the filter tables now instead of on the first event,
+      // ranges the controller doesn't declare still get baked then
+      int min;
+      int max;
+      if (desc.get_abs_range(abs, min, max))
+      {
+        it->event->get_lookup_offset(min, max);
+      }
     }
     catch(const std::exception& err)
     {
@@ -89,44 +109,102 @@ AxisMap::send_clear()
 }
 
 void
-AxisMap::send(const std::bitset<256>& button_state,
-              const boost::array<int, 256>& axis_state,
-              const boost::array<int, 256>& axis_min,
-              const boost::array<int, 256>& axis_max)
+AxisMap::send(const ControllerMessage& msg)
 {
+  const bool keys_changed = msg.keys_changed();
+
   for(int i = 0; i < static_cast<int>(m_map.size()); ++i)
   {
+    // neither the axis nor the combinations guarding it moved, so
+    // every AxisEvent would see the same input again
+    if (!keys_changed && !msg.abs_changed(i))
+    {
+      continue;
+    }
+
     Map& m = m_map[i];
-    m.update(button_state);
+    if (keys_changed)
+    {
+      m.update(msg.get_key_state());
+    }
+
+    const int value   = msg.get_abs(i);
+    const int abs_min = msg.get_abs_min(i);
+    const int abs_max = msg.get_abs_max(i);
 
     for(Map::iterator j = m.begin(); j != m.end(); ++j)
     {
       if (j->m_data)
       {
-        if (j->m_state)
-        {
-          j->m_data->send(axis_state[i], axis_min[i], axis_max[i]);
-        }
-        else
-        {
-          j->m_data->send((axis_max[i] - axis_min[i])/2 + axis_min[i], 
-                          axis_min[i], axis_max[i]);
-        }
+        const int raw = j->m_state ? value : (abs_max - abs_min)/2 + abs_min;
+        const int offset = j->m_data->get_lookup_offset(abs_min, abs_max);
+
+        m_batch_event.push_back(j->m_data.get());
+        m_batch_offset.push_back((abs_min <= raw && raw <= abs_max) ? offset : -1);
+        m_batch_raw.push_back(raw);
+        m_batch_min.push_back(abs_min);
+        m_batch_max.push_back(abs_max);
       }
     }
   }
+
+  const int count = static_cast<int>(m_batch_event.size());
+
+  // run the leading stateless filters of all events in one go, they
+  // are baked into tables, so this is a plain gather without any
+  // virtual calls, the base is only fetched now as baking new tables
+  // above may have moved it
+  m_batch_value.resize(count);
+  if (count > 0)
+  {
+    table_gather(m_tables->data(), &m_batch_offset[0], &m_batch_raw[0], &m_batch_min[0],
+                 &m_batch_value[0], count);
+  }
+
+  // stateful filters and the handlers still go per event
+  for(int k = 0; k < count; ++k)
+  {
+    if (m_batch_offset[k] >= 0)
+    {
+      m_batch_event[k]->send_prefiltered(m_batch_raw[k], m_batch_value[k], m_batch_min[k], m_batch_max[k]);
+    }
+    else
+    {
+      m_batch_event[k]->send(m_batch_raw[k], m_batch_min[k], m_batch_max[k]);
+    }
+  }
+
+  m_batch_event.clear();
+  m_batch_offset.clear();
+  m_batch_raw.clear();
+  m_batch_min.clear();
+  m_batch_max.clear();
 }
 
 void
-AxisMap::update(int msec_delta)
+AxisMap::update(int usec_delta)
 {
   for(std::vector<Mapping>::iterator it = m_mappings.begin(); it != m_mappings.end(); ++it)
   {
     if (it->event)
     {
-      it->event->update(msec_delta);
+      it->event->update(usec_delta);
+    }
+  }
+}
+
+int
+AxisMap::get_next_update() const
+{
+  int next = -1;
+  for(std::vector<Mapping>::const_iterator it = m_mappings.begin(); it != m_mappings.end(); ++it)
+  {
+    if (it->event)
+    {
+      next = earliest_update(next, it->event->get_next_update());
     }
   }
+  return next;
 }
 
 /* EOF */
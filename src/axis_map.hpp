@@ -19,12 +19,11 @@
 #ifndef HEADER_XBOXDRV_AXIS_MAP_HPP
 #define HEADER_XBOXDRV_AXIS_MAP_HPP
 
-#include <boost/array.hpp>
-
 #include "axis_event.hpp"
 #include "axis_map_option.hpp"
 #include "button_combination_map.hpp"
 
+class ControllerMessage;
 class ControllerMessageDescriptor;
 class UInput;
 
@@ -50,17 +49,29 @@ private:
   typedef std::vector<Map> AxisMapping;
   AxisMapping m_map;
 
+  /** shared by all events, so that every baked table hangs off a
+      single base pointer */
+  AxisTableCachePtr m_tables;
+
+  /** scratch space for send(), one entry per AxisEvent to send, kept
+      as separate arrays so the table lookups run as a single loop,
+      m_batch_offset is -1 for events without a table */
+  std::vector<AxisEvent*> m_batch_event;
+  std::vector<int> m_batch_offset;
+  std::vector<int> m_batch_raw;
+  std::vector<int> m_batch_value;
+  std::vector<int> m_batch_min;
+  std::vector<int> m_batch_max;
+
 public:
   AxisMap(const AxisMapOptions& opts, UInput& uinput, int slot, bool extra_devices);
 
   void init(const ControllerMessageDescriptor& desc);
 
-  void send(const std::bitset<256>& button_state,
-            const boost::array<int, 256>& axis_state,
-            const boost::array<int, 256>& axis_min,
-            const boost::array<int, 256>& axis_max);
+  void send(const ControllerMessage& msg);
   void send_clear();
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
 };
 
 #endif
@@ -0,0 +1,51 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "axis_table_cache.hpp"
+
+AxisTableCache::AxisTableCache() :
+  m_offsets(),
+  m_data()
+{
+}
+
+int
+AxisTableCache::find(const std::string& filters, int min, int max) const
+{
+  Offsets::const_iterator it = m_offsets.find(Key(filters, min, max));
+  if (it == m_offsets.end())
+  {
+    return -1;
+  }
+  else
+  {
+    return it->second;
+  }
+}
+
+int
+AxisTableCache::insert(const std::string& filters, int min, int max)
+{
+  const int offset = static_cast<int>(m_data.size());
+  m_data.resize(m_data.size() + (max - min + 1));
+  m_offsets[Key(filters, min, max)] = offset;
+  return offset;
+}
+
+/* EOF */
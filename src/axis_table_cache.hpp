@@ -0,0 +1,87 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_AXIS_TABLE_CACHE_HPP
+#define HEADER_XBOXDRV_AXIS_TABLE_CACHE_HPP
+
+#include <boost/shared_ptr.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+class AxisTableCache;
+
+typedef boost::shared_ptr<AxisTableCache> AxisTableCachePtr;
+
+/** Storage for the lookup tables AxisFilterChain bakes its stateless
+    filters into. All tables live back to back in a single array, so
+    a table is identified by its offset into data() and lookups for
+    any number of tables can share one base pointer. Tables are keyed
+    by the string of the filters they were baked from and their
+    range, so equal filter runs on equal axis share one table. */
+class AxisTableCache
+{
+private:
+  struct Key
+  {
+    std::string filters;
+    int min;
+    int max;
+
+    Key(const std::string& filters_, int min_, int max_) :
+      filters(filters_), min(min_), max(max_)
+    {}
+
+    bool operator<(const Key& rhs) const
+    {
+      if (min != rhs.min) return min < rhs.min;
+      if (max != rhs.max) return max < rhs.max;
+      return filters < rhs.filters;
+    }
+  };
+
+  typedef std::map<Key, int> Offsets;
+  Offsets m_offsets;
+  std::vector<int> m_data;
+
+public:
+  AxisTableCache();
+
+  /** Returns the offset of the table for \a filters and the given
+      range or -1 if there is none yet */
+  int find(const std::string& filters, int min, int max) const;
+
+  /** Adds a table for \a filters and the given range and returns its
+      offset, the max - min + 1 values at that offset are left for the
+      caller to fill in via data() */
+  int insert(const std::string& filters, int min, int max);
+
+  /** Start of all tables. The pointer changes when tables get
+      inserted, offsets stay valid. */
+  const int* data() const { return m_data.empty() ? 0 : &m_data[0]; }
+  int* data() { return m_data.empty() ? 0 : &m_data[0]; }
+
+private:
+  AxisTableCache(const AxisTableCache&);
+  AxisTableCache& operator=(const AxisTableCache&);
+};
+
+#endif
+
+/* EOF */
@@ -99,7 +99,7 @@ AbsAxisEventHandler::send(int value, int min, int max)
 }
  
 void
-AbsAxisEventHandler::update(int msec_delta)
+AbsAxisEventHandler::update(int usec_delta)
 {
 }
 
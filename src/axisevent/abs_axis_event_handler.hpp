@@ -34,7 +34,7 @@ public:
                       const UIEvent& code, int min, int max, int fuzz, int flat);
 
   void send(int value, int min, int max);
-  void update(int msec_delta);
+  void update(int usec_delta);
 
   std::string str() const;
 
@@ -144,7 +144,7 @@ KeyAxisEventHandler::send(int value, int min, int max)
 }
 
 void
-KeyAxisEventHandler::update(int msec_delta)
+KeyAxisEventHandler::update(int usec_delta)
 {
 }
 
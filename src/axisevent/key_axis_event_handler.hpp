@@ -36,7 +36,7 @@ public:
                       float threshold);
 
   void send(int value, int min, int max);
-  void update(int msec_delta);
+  void update(int usec_delta);
 
   std::string str() const;
 
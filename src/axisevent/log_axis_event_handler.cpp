@@ -32,7 +32,7 @@ LogAxisEventHandler::send(int value, int min, int max)
 }
 
 void
-LogAxisEventHandler::update(int msec_delta)
+LogAxisEventHandler::update(int usec_delta)
 {
 }
 
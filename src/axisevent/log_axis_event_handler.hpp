@@ -30,7 +30,7 @@ public:
   LogAxisEventHandler(const std::string& format);
 
   void send(int value, int min, int max);
-  void update(int msec_delta);
+  void update(int usec_delta);
 
   std::string str() const;
 
@@ -102,13 +102,13 @@ RelAxisEventHandler::send(int value, int min, int max)
 }
 
 void
-RelAxisEventHandler::update(int msec_delta)
+RelAxisEventHandler::update(int usec_delta)
 {
   if (m_repeat == -1 && m_stick_value != 0.0f)
   {
     // new and improved REL style event sending
 
-    float rel_value = m_stick_value * m_value * static_cast<float>(msec_delta) / 1000.0f;
+    float rel_value = m_stick_value * m_value * static_cast<float>(usec_delta) / 1000000.0f;
 
     // keep track of the rest that we lose when converting to integer
     rel_value += m_rest_value;
@@ -118,6 +118,13 @@ RelAxisEventHandler::update(int msec_delta)
   }
 }
 
+int
+RelAxisEventHandler::get_next_update() const
+{
+  // the old style repeat is driven by UInput itself
+  return (m_repeat == -1 && m_stick_value != 0.0f) ? 0 : -1;
+}
+
 std::string
 RelAxisEventHandler::str() const
 {
@@ -81,10 +81,10 @@ RelRepeatAxisEventHandler::send(int value, int min, int max)
 }
 
 void
-RelRepeatAxisEventHandler::update(int msec_delta)
+RelRepeatAxisEventHandler::update(int usec_delta)
 {
   // time ticks slower depending on how far the stick is moved
-  m_timer += static_cast<float>(msec_delta) * fabsf(m_stick_value);
+  m_timer += static_cast<float>(usec_delta) / 1000.0f * fabsf(m_stick_value);
 
   while(m_timer > m_repeat)
   {
@@ -101,6 +101,12 @@ RelRepeatAxisEventHandler::update(int msec_delta)
   }
 }
 
+int
+RelRepeatAxisEventHandler::get_next_update() const
+{
+  return (m_stick_value != 0.0f) ? 0 : -1;
+}
+
 std::string
 RelRepeatAxisEventHandler::str() const
 {
@@ -34,7 +34,8 @@ public:
                             const UIEvent& code, int value, float repeat);
 
   void send(int value, int min, int max);
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
 
   std::string str() const;
 
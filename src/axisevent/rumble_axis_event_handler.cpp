@@ -37,7 +37,7 @@ RumbleAxisEventHandler::send(int value, int min, int max)
 }
 
 void
-RumbleAxisEventHandler::update(int msec_delta)
+RumbleAxisEventHandler::update(int usec_delta)
 {
 }
   
@@ -31,7 +31,7 @@ public:
   RumbleAxisEventHandler();
 
   void send(int value, int min, int max);
-  void update(int msec_delta);
+  void update(int usec_delta);
   
   std::string str() const;
 
@@ -30,6 +30,7 @@ public:
   ConstAxisFilter(int value);
 
   int filter(int value, int min, int max);
+  bool is_stateless() const { return true; }
   std::string str() const;
 
 private:
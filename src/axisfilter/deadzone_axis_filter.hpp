@@ -30,6 +30,7 @@ public:
   DeadzoneAxisFilter(int min_deadzone, int max_deathzone, bool smooth);
 
   int filter(int value, int min, int max);
+  bool is_stateless() const { return true; }
   std::string str() const;
 
 private:
@@ -28,6 +28,7 @@ public:
   ~InvertAxisFilter() {}
 
   int filter(int value, int min, int max);
+  bool is_stateless() const { return true; }
   std::string str() const;
 };
 
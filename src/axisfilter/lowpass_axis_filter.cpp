@@ -19,6 +19,7 @@
 #include "axisfilter/lowpass_axis_filter.hpp"
 
 #include <boost/lexical_cast.hpp>
+#include <math.h>
 
 #include "helper.hpp"
 
@@ -36,10 +37,23 @@ LowpassAxisFilter::LowpassAxisFilter(float rate) :
 }
 
 void
-LowpassAxisFilter::update(int msec_delta)
+LowpassAxisFilter::update(int usec_delta)
 {
-  float rate = m_rate * static_cast<float>(msec_delta) / 1000.0f;
+  float rate = m_rate * static_cast<float>(usec_delta) / 1000000.0f;
   m_prev = m_prev + rate * (m_value - m_prev);
+
+  // snap to the target once the difference is below what the output
+  // can resolve, so the filter can come to rest
+  if (fabsf(m_value - m_prev) < 1.0e-5f)
+  {
+    m_prev = m_value;
+  }
+}
+
+int
+LowpassAxisFilter::get_next_update() const
+{
+  return (m_prev == m_value) ? -1 : 0;
 }
 
 int
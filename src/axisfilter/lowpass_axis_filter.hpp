@@ -34,7 +34,8 @@ private:
 public:
   LowpassAxisFilter(float rate);
 
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
   int filter(int value, int min, int max);
   std::string str() const;
 
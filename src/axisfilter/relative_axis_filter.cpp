@@ -52,12 +52,18 @@ RelativeAxisFilter::RelativeAxisFilter(int speed) :
 }
 
 void
-RelativeAxisFilter::update(int msec_delta)
+RelativeAxisFilter::update(int usec_delta)
 {
-  m_state += m_float_speed * m_value * static_cast<float>(msec_delta) / 1000.0f;
+  m_state += m_float_speed * m_value * static_cast<float>(usec_delta) / 1000000.0f;
   m_state = Math::clamp(-1.0f, m_state, 1.0f);
 }
 
+int
+RelativeAxisFilter::get_next_update() const
+{
+  return (m_value == 0.0f) ? -1 : 0;
+}
+
 int
 RelativeAxisFilter::filter(int value, int min, int max)
 {
@@ -29,7 +29,8 @@ public:
 public:
   RelativeAxisFilter(int speed);
 
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
   int filter(int value, int min, int max);
   std::string str() const;
 
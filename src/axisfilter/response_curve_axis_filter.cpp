@@ -20,6 +20,7 @@
 
 #include <boost/tokenizer.hpp>
 #include <boost/lexical_cast.hpp>
+#include <stdint.h>
 
 ResponseCurveAxisFilter*
 ResponseCurveAxisFilter::from_string(const std::string& str)
@@ -53,19 +54,28 @@ ResponseCurveAxisFilter::filter(int value, int min, int max)
   {
     return m_samples[0];
   }
+  else if (max <= min || value <= min)
+  {
+    return m_samples.front();
+  }
+  else if (value >= max)
+  {
+    return m_samples.back();
+  }
   else
   {
-    // FIXME: should rewrite this to use integer only and make sure
-    // that the edge conditions are meet
-    int   bucket_count = m_samples.size() - 1;
-    float bucket_size  = static_cast<float>(max - min) / static_cast<float>(bucket_count);
-      
-    int bucket_index = static_cast<int>(static_cast<float>(value - min) / bucket_size);
+    // position on the curve in units of 1/(max - min) buckets, kept
+    // in integers so that min and max hit the first and last sample
+    // exactly
+    const int64_t bucket_count = m_samples.size() - 1;
+    const int64_t range        = static_cast<int64_t>(max) - min;
+    const int64_t pos          = (static_cast<int64_t>(value) - min) * bucket_count;
+
+    const int     bucket_index = static_cast<int>(pos / range);
+    const int64_t t            = pos % range;
 
-    float t = (static_cast<float>(value - min) - (static_cast<float>(bucket_index) * bucket_size)) / bucket_size;
-      
-    return static_cast<int>(((1.0f - t) * static_cast<float>(m_samples[bucket_index])) + 
-                            (t * static_cast<float>(m_samples[bucket_index + 1])));
+    return static_cast<int>(m_samples[bucket_index] +
+                            (static_cast<int64_t>(m_samples[bucket_index + 1]) - m_samples[bucket_index]) * t / range);
   }
 }
 
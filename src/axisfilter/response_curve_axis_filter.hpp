@@ -30,6 +30,7 @@ public:
   ResponseCurveAxisFilter(const std::vector<int>& samples);
 
   int filter(int value, int min, int max);
+  bool is_stateless() const { return true; }
   std::string str() const;
 
 private:
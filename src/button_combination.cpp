@@ -40,19 +40,22 @@ ButtonCombination::from_string(const std::string& str)
 
 ButtonCombination::ButtonCombination() :
   m_buttons_str(),
-  m_buttons()
+  m_buttons(),
+  m_mask()
 {
 }
 
 ButtonCombination::ButtonCombination(const std::string& button) :
   m_buttons_str(1, button),
-  m_buttons()
+  m_buttons(),
+  m_mask()
 {
 }
 
 ButtonCombination::ButtonCombination(const std::vector<std::string>& buttons) :
   m_buttons_str(buttons),
-  m_buttons()
+  m_buttons(),
+  m_mask()
 {
 }
 
@@ -60,19 +63,16 @@ void
 ButtonCombination::init(const ControllerMessageDescriptor& desc)
 {
   m_buttons.clear();
+  m_mask.reset();
   for(ButtonsStr::const_iterator it = m_buttons_str.begin(); it != m_buttons_str.end(); ++it)
   {
-    m_buttons.push_back(desc.key().get(*it));
+    const int button = desc.key().get(*it);
+    m_buttons.push_back(button);
+    m_mask.set(button);
   }
   std::sort(m_buttons.begin(), m_buttons.end());
 }
 
-bool
-ButtonCombination::has_button(int button) const
-{
-  return std::find(m_buttons.begin(), m_buttons.end(), button) != m_buttons.end();
-}
-
 bool
 ButtonCombination::is_subset_of(const ButtonCombination& rhs) const
 {
@@ -80,14 +80,7 @@ ButtonCombination::is_subset_of(const ButtonCombination& rhs) const
   assert(m_buttons_str.size() == m_buttons.size());
   assert(rhs.m_buttons_str.size() == rhs.m_buttons.size());
 
-  for(Buttons::const_iterator i = m_buttons.begin(); i != m_buttons.end(); ++i)
-  {
-    if (!rhs.has_button(*i))
-    {
-      return false;
-    }
-  }
-  return true;
+  return (m_mask & ~rhs.m_mask).none();
 }
 
 int
@@ -102,14 +95,7 @@ ButtonCombination::match(const std::bitset<256>& button_state) const
   // check if init() was called
   assert(m_buttons_str.size() == m_buttons.size());
 
-  for(Buttons::const_iterator btn = m_buttons.begin(); btn != m_buttons.end(); ++btn)
-  {
-    if (!button_state[*btn])
-    {
-      return false;
-    }
-  }
-  return true;
+  return (button_state & m_mask) == m_mask;
 }
 
 void
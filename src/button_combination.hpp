@@ -41,6 +41,10 @@ public:
 
   bool match(const std::bitset<256>& button_state) const;
 
+  /** the buttons of the combination as a bitmask over key slots,
+      only valid after init() */
+  const std::bitset<256>& get_mask() const { return m_mask; }
+
   void print(std::ostream& os) const;
 
   bool is_subset_of(const ButtonCombination& rhs) const;
@@ -51,14 +55,12 @@ public:
 
   bool empty() const;
 
-private:
-  bool has_button(int button) const;
-
 private:
   typedef std::vector<std::string> ButtonsStr;
   typedef std::vector<int> Buttons;
   ButtonsStr m_buttons_str;
   Buttons    m_buttons;
+  std::bitset<256> m_mask;
 };
 
 std::ostream& operator<<(std::ostream& os, const ButtonCombination& buttons);
@@ -19,12 +19,23 @@
 #ifndef HEADER_XBOXDRV_BUTTON_COMBINATION_MAP_HPP
 #define HEADER_XBOXDRV_BUTTON_COMBINATION_MAP_HPP
 
+#include <bitset>
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 #include "button_combination.hpp"
 
 typedef boost::shared_ptr<ButtonCombination> ButtonCombinationPtr;
 
+/** Maps ButtonCombinations to data and tracks which of them are
+    active, a combination is suppressed while a superset of it is
+    held, so that e.g. LB+A doesn't also trigger A. When the same
+    combination is bound more than once the last binding wins.
+
+    init() compiles every combination into a bitmask and resolves the
+    superset relations into a table of mapping indices, update() then
+    only does a masked compare per mapping and a lookup per
+    superset. */
 template<typename C>
 class ButtonCombinationMap
 {
@@ -32,12 +43,15 @@ private:
   struct Mapping
   {
     ButtonCombinationPtr m_combo;
-    std::vector<ButtonCombinationPtr> m_supersets;
+    std::bitset<256> m_mask;
+    /** indices of the mappings whose combination is a superset of this one */
+    std::vector<int> m_supersets;
     bool m_state;
     C m_data;
 
     Mapping() :
       m_combo(),
+      m_mask(),
       m_supersets(),
       m_state(),
       m_data()
@@ -47,9 +61,13 @@ private:
   typedef std::vector<Mapping> Mappings;
   Mappings m_mappings;
 
+  /** per mapping result of the mask compare, scratch space for update() */
+  std::vector<char> m_match;
+
 public:
   ButtonCombinationMap() :
-    m_mappings()
+    m_mappings(),
+    m_match()
   {}
 
   void add(const ButtonCombination& combo, const C& data)
@@ -67,60 +85,63 @@ public:
     for(typename Mappings::iterator it = m_mappings.begin(); it != m_mappings.end(); ++it)
     {
       it->m_combo->init(desc);
+      it->m_mask = it->m_combo->get_mask();
       it->m_supersets.clear();
     }
 
-    // BROKEN: need to filter out duplicate bindings
-
     // regenerate superset mappings
-    for(typename Mappings::iterator it = m_mappings.begin(); it != m_mappings.end(); ++it)
-    { 
-      // find which already bound combinations the new one is a
-      // superset of and add it to the list
-      for(typename Mappings::iterator j = m_mappings.begin(); j != m_mappings.end(); ++j)
+    const int count = static_cast<int>(m_mappings.size());
+    for(int i = 0; i < count; ++i)
+    {
+      // find which other bound combinations are a superset of this
+      // one and add them to the list, of duplicate combinations only
+      // the later one counts as superset, so it overrides the earlier
+      // instead of both suppressing each other
+      for(int j = 0; j < count; ++j)
       {
-        if (&*it != &*j)
+        if (i != j && m_mappings[i].m_combo->is_subset_of(*m_mappings[j].m_combo) &&
+            (j > i || m_mappings[i].m_mask != m_mappings[j].m_mask))
         {
-          if (it->m_combo->is_subset_of(*j->m_combo))
-          {
-            it->m_supersets.push_back(j->m_combo);
-          }
+          m_mappings[i].m_supersets.push_back(j);
         }
       }
     }
+
+    m_match.assign(m_mappings.size(), 0);
+
+    // start out from the no-buttons-pressed state, so that users
+    // only need to call update() when the button state changed
+    update(std::bitset<256>());
   }
 
   void update(const std::bitset<256>& button_state)
   {
-    for(typename Mappings::iterator i = m_mappings.begin(); i != m_mappings.end(); ++i)
+    const int count = static_cast<int>(m_mappings.size());
+
+    for(int i = 0; i < count; ++i)
+    {
+      const std::bitset<256>& mask = m_mappings[i].m_mask;
+      m_match[i] = ((button_state & mask) == mask);
+    }
+
+    for(int i = 0; i < count; ++i)
     {
-      if (i->m_combo->match(button_state))
+      Mapping& mapping = m_mappings[i];
+      mapping.m_state = m_match[i];
+
+      if (mapping.m_state)
       {
-        // check if a superset matches
-        bool superset_matches = false;
-        for(std::vector<ButtonCombinationPtr>::iterator j = i->m_supersets.begin(); j != i->m_supersets.end(); ++j)
-        {      
-          if ((*j)->match(button_state))
+        // a held superset suppresses this combination
+        for(std::vector<int>::const_iterator j = mapping.m_supersets.begin(); j != mapping.m_supersets.end(); ++j)
+        {
+          if (m_match[*j])
           {
-            superset_matches = true;
+            mapping.m_state = false;
             break;
           }
         }
-
-        if (superset_matches)
-        {
-          i->m_state = false;
-        }
-        else
-        {
-          i->m_state = true;
-        }
-      }
-      else
-      {
-        i->m_state = false;
       }
-    }   
+    }
   }
 
   typedef typename Mappings::iterator iterator;
@@ -128,6 +149,9 @@ public:
 
   iterator begin() { return m_mappings.begin(); }
   iterator end()   { return m_mappings.end(); }
+
+  const_iterator begin() const { return m_mappings.begin(); }
+  const_iterator end() const   { return m_mappings.end(); }
 };
 
 #endif
@@ -23,6 +23,7 @@
 #include <fstream>
 
 #include "evdev_helper.hpp"
+#include "helper.hpp"
 #include "log.hpp"
 #include "path.hpp"
 
@@ -77,18 +78,29 @@ ButtonEvent::send_clear()
 }
 
 void
-ButtonEvent::update(int msec_delta)
+ButtonEvent::update(int usec_delta)
 {
   for(std::vector<ButtonFilterPtr>::const_iterator i = m_filters.begin(); i != m_filters.end(); ++i)
   {
-    (*i)->update(msec_delta);
+    (*i)->update(usec_delta);
   }
 
-  m_handler->update(msec_delta);
+  m_handler->update(usec_delta);
   
   send(m_last_raw_state);
 }
 
+int
+ButtonEvent::get_next_update() const
+{
+  int next = m_handler->get_next_update();
+  for(std::vector<ButtonFilterPtr>::const_iterator i = m_filters.begin(); i != m_filters.end(); ++i)
+  {
+    next = earliest_update(next, (*i)->get_next_update());
+  }
+  return next;
+}
+
 std::string
 ButtonEvent::str() const
 {
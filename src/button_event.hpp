@@ -36,7 +36,8 @@ public:
 
   void send(bool value);
   void send_clear();
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
   std::string str() const;
 
   void add_filters(const std::vector<ButtonFilterPtr>& filters);
@@ -56,7 +57,11 @@ public:
   
   virtual void send(bool value) =0;
   virtual void send_clear() { send(false); }
-  virtual void update(int msec_delta) =0;
+  virtual void update(int usec_delta) =0;
+  /** Returns the msec until update() has to be called again, 0 for
+      the next tick or -1 when there is no time dependent state and
+      update() would not change anything */
+  virtual int get_next_update() const { return -1; }
   virtual std::string str() const =0;
 };
 
@@ -36,7 +36,11 @@ public:
   virtual ~ButtonFilter() {}
 
   virtual bool filter(bool value) =0;
-  virtual void update(int msec_delta) {}
+  virtual void update(int usec_delta) {}
+  /** Returns the msec until update() has to be called again, 0 for
+      the next tick or -1 when there is no time dependent state and
+      update() would not change anything */
+  virtual int get_next_update() const { return -1; }
   virtual std::string str() const = 0;
 };
 
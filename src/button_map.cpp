@@ -21,6 +21,8 @@
 #include <iostream>
 
 #include "button_event_factory.hpp"
+#include "controller_message.hpp"
+#include "helper.hpp"
 
 ButtonMap::ButtonMap(const ButtonMapOptions& opts, UInput& uinput, int slot, bool extra_devices) :
   m_map()
@@ -108,9 +110,16 @@ ButtonMap::bind(const ButtonCombination& buttons, ButtonEventPtr event)
 }
 
 void
-ButtonMap::send(const std::bitset<256>& button_state)
+ButtonMap::send(const ControllerMessage& msg)
 {
-  m_map.update(button_state);
+  // combinations can only change state when a key did, time based
+  // filters are driven from update() instead
+  if (!msg.keys_changed())
+  {
+    return;
+  }
+
+  m_map.update(msg.get_key_state());
 
   for(Map::iterator i = m_map.begin(); i != m_map.end(); ++i)
   {
@@ -134,15 +143,29 @@ ButtonMap::send_clear()
 }
 
 void
-ButtonMap::update(int msec_delta)
+ButtonMap::update(int usec_delta)
+{
+  for(Map::const_iterator i = m_map.begin(); i != m_map.end(); ++i)
+  {
+    if (i->m_data)
+    {
+      i->m_data->update(usec_delta);
+    }
+  }
+}
+
+int
+ButtonMap::get_next_update() const
 {
+  int next = -1;
   for(Map::const_iterator i = m_map.begin(); i != m_map.end(); ++i)
   {
     if (i->m_data)
     {
-      i->m_data->update(msec_delta);
+      next = earliest_update(next, i->m_data->get_next_update());
     }
   }
+  return next;
 }
 
 /* EOF */
@@ -28,6 +28,7 @@
 #include "button_event.hpp"
 #include "button_map_option.hpp"
 
+class ControllerMessage;
 class UInput;
 
 class ButtonMap
@@ -41,9 +42,10 @@ public:
 
   void init(const ControllerMessageDescriptor& desc);
 
-  void send(const std::bitset<256>& button_state);
+  void send(const ControllerMessage& msg);
   void send_clear();
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
 
 private:
   /** Bind a combination of multiple buttons to an event (i.e. "LB+A=KEY_A") */
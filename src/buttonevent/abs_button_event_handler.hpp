@@ -35,7 +35,7 @@ public:
                         int code);
 
   void send(bool value);
-  void update(int msec_delta) {}
+  void update(int usec_delta) {}
 
   std::string str() const;
 
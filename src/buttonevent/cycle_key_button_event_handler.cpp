@@ -191,7 +191,7 @@ CycleKeyButtonEventHandler::send(bool value)
 }
 
 void
-CycleKeyButtonEventHandler::update(int msec_delta)
+CycleKeyButtonEventHandler::update(int usec_delta)
 {
 }
 
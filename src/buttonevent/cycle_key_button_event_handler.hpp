@@ -66,7 +66,7 @@ private:
 
 public:
   void send(bool value);
-  void update(int msec_delta);
+  void update(int usec_delta);
 
   std::string str() const;
 
@@ -30,7 +30,7 @@ public:
   ExecButtonEventHandler(const std::vector<std::string>& args);
 
   void send(bool value);
-  void update(int msec_delta) {}
+  void update(int usec_delta) {}
 
   std::string str() const;
 
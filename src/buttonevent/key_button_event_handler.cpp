@@ -18,10 +18,12 @@
 
 #include "buttonevent/key_button_event_handler.hpp"
 
+#include <algorithm>
 #include <boost/tokenizer.hpp>
 #include <linux/input.h>
 
 #include "evdev_helper.hpp"
+#include "helper.hpp"
 #include "uinput.hpp"
 
 KeyButtonEventHandler*
@@ -81,7 +83,7 @@ KeyButtonEventHandler::KeyButtonEventHandler(UInput& uinput, int slot, bool extr
   m_codes(codes),
   m_secondary_codes(secondary_codes),
   m_hold_threshold(0),
-  m_hold_counter(hold_threshold),
+  m_hold_counter(hold_threshold * 1000),
   m_release_scheduled(false)
 {
   m_codes.init(uinput, slot, extra_devices);
@@ -105,7 +107,7 @@ KeyButtonEventHandler::send(bool value)
     }
     else
     {
-      if (m_hold_counter < m_hold_threshold)
+      if (m_hold_counter < m_hold_threshold * 1000)
       {
         if (m_state)
         {
@@ -116,7 +118,7 @@ KeyButtonEventHandler::send(bool value)
         {
           // send both a press and release event after another, aka a "click"
           m_codes.send(true);
-          m_release_scheduled = 50;
+          m_release_scheduled = 50 * 1000; // 50 msec
         }
       }
       else
@@ -140,11 +142,11 @@ KeyButtonEventHandler::send(bool value)
 }
 
 void
-KeyButtonEventHandler::update(int msec_delta) 
+KeyButtonEventHandler::update(int usec_delta) 
 {
   if (m_release_scheduled)
   {
-    m_release_scheduled -= msec_delta;
+    m_release_scheduled -= usec_delta;
 
     if (m_release_scheduled <= 0)
     {
@@ -155,21 +157,39 @@ KeyButtonEventHandler::update(int msec_delta)
 
   if (m_state && m_hold_threshold)
   {
-    if (m_hold_counter < m_hold_threshold &&
-        m_hold_counter + msec_delta >= m_hold_threshold)
+    if (m_hold_counter < m_hold_threshold * 1000 &&
+        m_hold_counter + usec_delta >= m_hold_threshold * 1000)
     {
       // start sending the secondary events
       m_secondary_codes.send(true);
       //uinput.sync(); BROKEN: must sync
     }
 
-    if (m_hold_counter < m_hold_threshold)
+    if (m_hold_counter < m_hold_threshold * 1000)
     {
-      m_hold_counter += msec_delta;
+      m_hold_counter += usec_delta;
     }
   }
 }
 
+int
+KeyButtonEventHandler::get_next_update() const
+{
+  int next = -1;
+
+  if (m_release_scheduled)
+  {
+    next = usec_to_msec_ceil(m_release_scheduled);
+  }
+
+  if (m_state && m_hold_threshold && m_hold_counter < m_hold_threshold * 1000)
+  {
+    next = earliest_update(next, usec_to_msec_ceil(m_hold_threshold * 1000 - m_hold_counter));
+  }
+
+  return next;
+}
+
 std::string
 KeyButtonEventHandler::str() const
 {
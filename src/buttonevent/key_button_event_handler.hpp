@@ -36,7 +36,8 @@ public:
                         int m_hold_threshold);
 
   void send(bool value);
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
 
   std::string str() const;
   
@@ -46,8 +47,8 @@ private:
   UIEventSequence m_secondary_codes;
 
   int m_hold_threshold;
-  int m_hold_counter;
-  int m_release_scheduled;
+  int m_hold_counter; /// usec
+  int m_release_scheduled; /// usec
 };
 
 #endif
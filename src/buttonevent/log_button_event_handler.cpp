@@ -32,7 +32,7 @@ LogButtonEventHandler::send(bool value)
 }
 
 void
-LogButtonEventHandler::update(int msec_delta)
+LogButtonEventHandler::update(int usec_delta)
 {
 }
 
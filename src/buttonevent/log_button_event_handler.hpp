@@ -30,7 +30,7 @@ public:
   LogButtonEventHandler(const std::string& format);
   
   void send(bool value);
-  void update(int msec_delta);
+  void update(int usec_delta);
   std::string str() const;
 
 private:
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "evdev_helper.hpp"
+#include "helper.hpp"
 #include "log.hpp"
 #include "raise_exception.hpp"
 #include "uinput.hpp"
@@ -289,11 +290,11 @@ MacroButtonEventHandler::send(bool value)
 }
 
 void
-MacroButtonEventHandler::update(int msec_delta)
+MacroButtonEventHandler::update(int usec_delta)
 {
   if (m_send_in_progress)
   {
-    m_countdown -= msec_delta;
+    m_countdown -= usec_delta;
     if (m_countdown <= 0)
     {
       while(true)
@@ -308,7 +309,9 @@ MacroButtonEventHandler::update(int msec_delta)
             break;
 
           case MacroEvent::kWaitOp:
-            m_countdown = m_events[m_event_counter].wait.msec;
+            // keep the overshoot of the last wait, so that a
+            // sequence of waits doesn't drift
+            m_countdown += m_events[m_event_counter].wait.msec * 1000;
             if (m_countdown > 0)
             {
               m_event_counter += 1;
@@ -342,6 +345,12 @@ MacroButtonEventHandler::update(int msec_delta)
   }
 }
 
+int
+MacroButtonEventHandler::get_next_update() const
+{
+  return m_send_in_progress ? usec_to_msec_ceil(m_countdown) : -1;
+}
+
 std::string
 MacroButtonEventHandler::str() const
 {
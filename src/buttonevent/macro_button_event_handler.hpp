@@ -62,7 +62,8 @@ public:
   ~MacroButtonEventHandler();
 
   void send(bool value);
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
 
   std::string str() const;
 
@@ -75,7 +76,7 @@ private:
 private:
   std::vector<MacroEvent> m_events;
   bool m_send_in_progress;
-  int m_countdown;
+  int m_countdown; /// usec
   std::vector<MacroEvent>::size_type m_event_counter;
 
   typedef std::map<UIEvent, UIEventEmitterPtr> Emitter;
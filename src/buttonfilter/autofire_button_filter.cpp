@@ -53,19 +53,26 @@ AutofireButtonFilter::AutofireButtonFilter(int rate, int delay) :
 }
 
 void
-AutofireButtonFilter::update(int msec_delta)
+AutofireButtonFilter::update(int usec_delta)
 {
   if (m_state)
   {
-    m_counter += msec_delta;
+    m_counter += usec_delta;
 
-    if (m_counter > m_delay)
+    if (m_counter > m_delay * 1000)
     {
       m_autofire = true;
     }
   }
 }
 
+int
+AutofireButtonFilter::get_next_update() const
+{
+  // the output toggles on every other tick while the button is held
+  return m_state ? 0 : -1;
+}
+
 bool
 AutofireButtonFilter::filter(bool value)
 {
@@ -81,7 +88,7 @@ AutofireButtonFilter::filter(bool value)
   { // auto fire
     if (m_autofire)
     {
-      if (m_counter > m_rate)
+      if (m_counter > m_rate * 1000)
       {
         m_counter = 0;
         return true;
@@ -29,7 +29,8 @@ public:
 public:
   AutofireButtonFilter(int rate, int delay);
 
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
   bool filter(bool value);
   std::string str() const;
 
@@ -40,7 +41,7 @@ private:
   /** msec between shots */
   int m_rate;
   int m_delay;
-  int m_counter;
+  int m_counter; /// usec
 };
 
 #endif
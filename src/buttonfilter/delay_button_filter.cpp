@@ -20,6 +20,8 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include "helper.hpp"
+
 DelayButtonFilter*
 DelayButtonFilter::from_string(const std::string& str)
 {
@@ -28,16 +30,19 @@ DelayButtonFilter::from_string(const std::string& str)
 
 DelayButtonFilter::DelayButtonFilter(int delay) :
   m_delay(delay),
-  m_time(0)
+  m_time(0),
+  m_pressed(false)
 {
 }
 
 bool
 DelayButtonFilter::filter(bool value)
 {
+  m_pressed = value;
+
   if (value)
   {
-    if (m_time < m_delay)
+    if (m_time < m_delay * 1000)
     {
       return false;
     }
@@ -54,9 +59,27 @@ DelayButtonFilter::filter(bool value)
 }
 
 void
-DelayButtonFilter::update(int msec_delta)
+DelayButtonFilter::update(int usec_delta)
+{
+  // only count the time the button is held, so a long idle period
+  // doesn't count towards the delay
+  if (m_pressed && m_time < m_delay * 1000)
+  {
+    m_time += usec_delta;
+  }
+}
+
+int
+DelayButtonFilter::get_next_update() const
 {
-  m_time += msec_delta;
+  if (m_pressed && m_time < m_delay * 1000)
+  {
+    return usec_to_msec_ceil(m_delay * 1000 - m_time);
+  }
+  else
+  {
+    return -1;
+  }
 }
 
 std::string
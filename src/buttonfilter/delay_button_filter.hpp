@@ -33,13 +33,15 @@ public:
   DelayButtonFilter(int delay);
 
   bool filter(bool value);
-  void update(int msec_delta);
+  void update(int usec_delta);
+  int get_next_update() const;
 
   std::string str() const;
 
 private:
   int m_delay;
-  int m_time;
+  int m_time; /// usec
+  bool m_pressed;
 };
 
 #endif
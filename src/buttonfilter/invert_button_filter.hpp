@@ -26,7 +26,7 @@ class InvertButtonFilter : public ButtonFilter
 public:
   InvertButtonFilter() {}
 
-  void update(int msec_delta) {}
+  void update(int usec_delta) {}
   bool filter(bool value);
   std::string str() const;
 };
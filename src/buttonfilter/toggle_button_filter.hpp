@@ -27,7 +27,7 @@ public:
   ToggleButtonFilter();
 
   bool filter(bool value);
-  void update(int msec_delta) {}
+  void update(int usec_delta) {}
   std::string str() const;
 
 private:
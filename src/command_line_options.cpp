@@ -56,6 +56,13 @@ enum {
   OPTION_QUIET,
   OPTION_SILENT,
   OPTION_USB_DEBUG,
+  OPTION_USB_READ_QUEUE,
+  OPTION_USB_THREAD,
+  OPTION_USB_THREAD_PRIORITY,
+  OPTION_USB_HOTPLUG,
+  OPTION_USB_TRACE,
+  OPTION_REPLAY,
+  OPTION_REPLAY_FAST,
   OPTION_DAEMON,
   OPTION_CONFIG_OPTION,
   OPTION_CONFIG,
@@ -110,6 +117,7 @@ enum {
   OPTION_DEVICE_BY_ID,
   OPTION_DEVICE_BY_PATH,
   OPTION_GENERIC_USB_SPEC,
+  OPTION_GENERIC_USB_LAYOUT,
   OPTION_LIST_SUPPORTED_DEVICES,
   OPTION_LIST_SUPPORTED_DEVICES_XPAD,
   OPTION_LIST_CONTROLLER,
@@ -212,6 +220,14 @@ CommandLineParser::init_argp()
     .add_option(OPTION_TYPE,           0, "type",    "TYPE", "Ignore autodetection and enforce controller type (xbox, xbox-mat, xbox360, xbox360-wireless, xbox360-guitar)")
     .add_option(OPTION_DETACH_KERNEL_DRIVER, 'd', "detach-kernel-driver", "", "Detaches the kernel driver currently associated with the device")
     .add_option(OPTION_GENERIC_USB_SPEC, 0, "generic-usb-spec", "SPEC", "Specification for generic USB device")
+    .add_option(OPTION_GENERIC_USB_LAYOUT, 0, "generic-usb-layout", "MAP", "Report layout for generic USB device (example: xbox.x1=1:s8,xbox.a=5.0)")
+    .add_option(OPTION_USB_READ_QUEUE, 0, "usb-read-queue", "N", "Number of USB read transfers kept in flight per endpoint (default: 2)")
+    .add_option(OPTION_USB_THREAD,     0, "usb-thread", "", "Handle USB events in a separate thread instead of the main loop")
+    .add_option(OPTION_USB_THREAD_PRIORITY, 0, "usb-thread-priority", "PRI", "Scheduling priority of the USB thread (default: normal)")
+    .add_option(OPTION_USB_HOTPLUG,    0, "usb-hotplug", "", "Discover USB devices via libusb hotplug callbacks instead of scanning or udev")
+    .add_option(OPTION_USB_TRACE,      0, "usb-trace", "FILE", "Record all USB transfers into a binary trace FILE")
+    .add_option(OPTION_REPLAY,         0, "replay", "FILE", "Replay a trace recorded with --usb-trace instead of reading from USB (requires --type)")
+    .add_option(OPTION_REPLAY_FAST,    0, "replay-fast", "", "Replay the trace as fast as possible instead of in real time")
     .add_newline()
 
     .add_text("Evdev Options: ")
@@ -355,6 +371,11 @@ CommandLineParser::init_ini(Options* opts)
     ("silent", &opts->silent)
     ("quiet",  &opts->quiet)
     ("usb-debug",  &opts->usb_debug)
+    ("usb-read-queue", &opts->usb_read_queue)
+    ("usb-thread", &opts->usb_thread)
+    ("usb-thread-priority", boost::bind(&Options::set_usb_thread_priority, opts, _1))
+    ("usb-hotplug", &opts->usb_hotplug)
+    ("usb-trace", &opts->usb_trace)
     ("rumble", &opts->rumble)
     ("led", boost::bind(&Options::set_led, opts, _1))
     ("rumble-l", &opts->rumble_l)
@@ -372,6 +393,8 @@ CommandLineParser::init_ini(Options* opts)
     ("evdev", &opts->evdev_device)
     ("evdev-grab", &opts->evdev_grab)
     ("evdev-debug", &opts->evdev_debug)
+    ("replay", &opts->replay_file)
+    ("replay-fast", &opts->replay_fast)
     ("config", boost::bind(&CommandLineParser::read_config_file, this, _1))
     ("alt-config", boost::bind(&CommandLineParser::read_alt_config_file, this, _1))
     ("timeout", &opts->timeout)
@@ -440,6 +463,7 @@ CommandLineParser::init_ini(Options* opts)
   m_ini.section("axis-sensitivity",   boost::bind(&CommandLineParser::set_axis_sensitivity, this, _1, _2));
   m_ini.section("device-name", boost::bind(&CommandLineParser::set_device_name, this, _1, _2));
   m_ini.section("device-usbid", boost::bind(&CommandLineParser::set_device_usbid, this, _1, _2));
+  m_ini.section("generic-usb-layout", boost::bind(&CommandLineParser::set_generic_usb_layout, this, _1, _2));
 
   for(int controller = 0; controller <= 9; ++controller)
   {
@@ -516,6 +540,34 @@ CommandLineParser::parse_args(int argc, char** argv, Options* options)
         opts.set_usb_debug();
         break;
 
+      case OPTION_USB_READ_QUEUE:
+        opts.usb_read_queue = boost::lexical_cast<int>(opt.argument);
+        break;
+
+      case OPTION_USB_THREAD:
+        opts.usb_thread = true;
+        break;
+
+      case OPTION_USB_THREAD_PRIORITY:
+        opts.set_usb_thread_priority(opt.argument);
+        break;
+
+      case OPTION_USB_HOTPLUG:
+        opts.usb_hotplug = true;
+        break;
+
+      case OPTION_USB_TRACE:
+        opts.usb_trace = opt.argument;
+        break;
+
+      case OPTION_REPLAY:
+        opts.replay_file = opt.argument;
+        break;
+
+      case OPTION_REPLAY_FAST:
+        opts.replay_fast = true;
+        break;
+
       case OPTION_PRIORITY:
         opts.set_priority(opt.argument);
         break;
@@ -954,6 +1006,10 @@ CommandLineParser::parse_args(int argc, char** argv, Options* options)
       case OPTION_GENERIC_USB_SPEC:
         set_generic_usb_spec(opt.argument);
         break;
+
+      case OPTION_GENERIC_USB_LAYOUT:
+        process_name_value_string(opt.argument, boost::bind(&CommandLineParser::set_generic_usb_layout, this, _1, _2));
+        break;
     
       case OPTION_LIST_SUPPORTED_DEVICES:
         opts.mode = Options::RUN_LIST_SUPPORTED_DEVICES;
@@ -1376,6 +1432,12 @@ CommandLineParser::set_generic_usb_spec(const std::string& spec)
   m_options->m_generic_usb_specs.push_back(Options::GenericUSBSpec::from_string(spec));
 }
 
+void
+CommandLineParser::set_generic_usb_layout(const std::string& name, const std::string& value)
+{
+  m_options->generic_usb_layout.push_back(ReportField::from_string(name, value));
+}
+
 std::string
 CommandLineParser::get_directory_context() const
 {
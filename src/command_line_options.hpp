@@ -102,6 +102,7 @@ private:
   void mouse();
 
   void set_generic_usb_spec(const std::string& name);
+  void set_generic_usb_layout(const std::string& name, const std::string& value);
 
 private:
   void init_argp();
@@ -85,6 +85,9 @@ public:
   void set_udev_device(udev_device* udev_dev);
   udev_device* get_udev_device() const;
 
+  /** Hands \a msg over to the message callback. The message is not
+      copied, it has to stay valid until the next submit_msg() call,
+      so the receiver can keep a reference to it. */
   void submit_msg(const ControllerMessage& msg, const ControllerMessageDescriptor& msg_desc);
 
 
@@ -51,7 +51,8 @@ EvdevController::EvdevController(const std::string& filename,
   m_relmap(),
   m_absinfo(ABS_MAX),
   m_event_buffer(),
-  m_msg()
+  m_msg(),
+  m_msg_slot()
 {
   m_fd = open(filename.c_str(), O_RDONLY | O_NONBLOCK);
 
@@ -115,6 +116,7 @@ EvdevController::EvdevController(const std::string& filename,
           // install custom user supplied mapping
           m_absmap[i] = m_message_descriptor.abs().put("evdev." + it->second);
         }
+        m_message_descriptor.set_abs_range(m_absmap[i], absinfo.minimum, absinfo.maximum);
       }
     }
 
@@ -297,7 +299,7 @@ EvdevController::on_read_data(GIOChannel* source, GIOCondition condition)
     {
       if (ev[i].type == EV_SYN)
       {
-        submit_msg(m_msg, m_message_descriptor);
+        submit_msg(m_msg_slot.commit(m_msg), m_message_descriptor);
       }
       else
       {
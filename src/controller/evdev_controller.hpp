@@ -26,6 +26,7 @@
 
 #include "controller.hpp"
 #include "controller_message.hpp"
+#include "controller_message_slot.hpp"
 
 class EvdevController : public Controller
 {
@@ -46,8 +47,13 @@ private:
   typedef std::queue<struct input_event> EventBuffer;
   EventBuffer m_event_buffer;
 
+  /** the state built up from the events since the last EV_SYN */
   ControllerMessage m_msg;
 
+  /** the submitted copies of m_msg, they have to stay untouched
+      while m_msg is updated by the next events */
+  ControllerMessageSlot m_msg_slot;
+
 public:
   EvdevController(const std::string& filename, 
                   const std::map<int, std::string>& absmap,
@@ -88,6 +88,11 @@ FirestormDualController::FirestormDualController(libusb_device* dev, bool is_vsb
   is_vsb(is_vsb_),
   xbox(m_message_descriptor)
 {
+  m_message_descriptor.set_abs_range(xbox.abs_x1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_x2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y2, -32768, 32767);
+
   usb_claim_interface(0, try_detach);
 
   if (is_vsb)
@@ -102,6 +107,7 @@ FirestormDualController::FirestormDualController(libusb_device* dev, bool is_vsb
 
 FirestormDualController::~FirestormDualController()
 {
+  usb_close();
 }
 
 void
@@ -110,11 +116,11 @@ FirestormDualController::set_rumble_real(uint8_t left, uint8_t right)
   uint8_t cmd[] = { left, right, 0x00, 0x00 };
   if (is_vsb)
   {
-    usb_control(0x21, 0x09, 0x0200, 0x00, cmd, sizeof(cmd));
+    usb_control_coalesced(kOutputRumble, 0x21, 0x09, 0x0200, 0x00, cmd, sizeof(cmd));
   }
   else
   {
-    usb_control(0x21, 0x09, 0x02, 0x00, cmd, sizeof(cmd));
+    usb_control_coalesced(kOutputRumble, 0x21, 0x09, 0x02, 0x00, cmd, sizeof(cmd));
   }
 }
 
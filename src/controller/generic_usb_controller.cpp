@@ -21,14 +21,20 @@
 #include <iostream>
 
 #include "helper.hpp"
+#include "hid_report_descriptor.hpp"
+#include "log.hpp"
 #include "raise_exception.hpp"
+#include "usb_helper.hpp"
 
 GenericUSBController::GenericUSBController(libusb_device* dev, 
                                            int interface, int endpoint,
+                                           const std::vector<ReportField>& layout,
                                            bool try_detach) :
   USBController(dev),
   m_interface(interface),
-  m_endpoint(endpoint)
+  m_endpoint(endpoint),
+  m_parser(),
+  m_report_id(-1)
 {
   struct libusb_config_descriptor* config;
   if (libusb_get_active_config_descriptor(dev, &config) != LIBUSB_SUCCESS)
@@ -75,6 +81,24 @@ GenericUSBController::GenericUSBController(libusb_device* dev,
 
       log_debug("wMaxPacketSize: " << wMaxPacketSize);
       usb_claim_interface(m_interface, try_detach);
+
+      if (!layout.empty())
+      {
+        m_parser.reset(new ReportParser(layout, m_message_descriptor));
+      }
+      else
+      {
+        // without an explicit layout, fall back to what the device
+        // tells about itself
+        std::vector<ReportField> hid_layout = read_hid_layout(config->interface[m_interface].altsetting[0]);
+        if (!hid_layout.empty())
+        {
+          log_info("using HID report descriptor: " << hid_layout.size() << " fields"
+                   << ", report id " << m_report_id);
+          m_parser.reset(new ReportParser(hid_layout, m_message_descriptor));
+        }
+      }
+
       usb_submit_read(m_endpoint, wMaxPacketSize);
     }
   }
@@ -82,6 +106,57 @@ GenericUSBController::GenericUSBController(libusb_device* dev,
 
 GenericUSBController::~GenericUSBController()
 {
+  usb_close();
+}
+
+std::vector<ReportField>
+GenericUSBController::read_hid_layout(const libusb_interface_descriptor& intf)
+{
+  if (intf.bInterfaceClass != LIBUSB_CLASS_HID)
+  {
+    return std::vector<ReportField>();
+  }
+
+  // the HID class descriptor follows the interface descriptor and
+  // holds the length of the report descriptor
+  int length = -1;
+  const unsigned char* end = intf.extra + intf.extra_length;
+  for(const unsigned char* p = intf.extra; p + 2 <= end && p[0] >= 2 && p + p[0] <= end; p += p[0])
+  {
+    if (p[1] == LIBUSB_DT_HID && p[0] >= 9)
+    {
+      // bNumDescriptors followed by (bDescriptorType, wDescriptorLength)
+      for(int i = 0; i < p[5] && 6 + 3*i + 2 < p[0]; ++i)
+      {
+        if (p[6 + 3*i] == LIBUSB_DT_REPORT)
+        {
+          length = p[7 + 3*i] | (p[8 + 3*i] << 8);
+        }
+      }
+    }
+  }
+
+  if (length <= 0)
+  {
+    log_warn("HID interface " << m_interface << " has no report descriptor");
+    return std::vector<ReportField>();
+  }
+
+  std::vector<uint8_t> data(length);
+  int ret = libusb_control_transfer(m_handle,
+                                    LIBUSB_ENDPOINT_IN | LIBUSB_REQUEST_TYPE_STANDARD | LIBUSB_RECIPIENT_INTERFACE,
+                                    LIBUSB_REQUEST_GET_DESCRIPTOR,
+                                    LIBUSB_DT_REPORT << 8, static_cast<uint16_t>(m_interface),
+                                    &data[0], static_cast<uint16_t>(length), 1000);
+  if (ret < 0)
+  {
+    log_warn("failed to read HID report descriptor: " << usb_strerror(ret));
+    return std::vector<ReportField>();
+  }
+
+  HIDReportDescriptor descriptor(&data[0], ret);
+  m_report_id = descriptor.get_report_id();
+  return descriptor.get_layout();
 }
 
 void
@@ -120,8 +195,20 @@ GenericUSBController::set_led_real(uint8_t status)
 bool
 GenericUSBController::parse(const uint8_t* data, int len, ControllerMessage* msg_out)
 {
-  std::cout << "GenericUSBController:parse(): " << raw2str(data, len) << std::endl;
-  return false;
+  if (m_parser)
+  {
+    if (m_report_id != -1 && (len < 1 || data[0] != m_report_id))
+    {
+      return false;
+    }
+
+    return m_parser->parse(data, len, msg_out);
+  }
+  else
+  {
+    std::cout << "GenericUSBController:parse(): " << raw2str(data, len) << std::endl;
+    return false;
+  }
 }
 
 /* EOF */
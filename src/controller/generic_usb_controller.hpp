@@ -19,10 +19,13 @@
 #ifndef HEADER_XBOXDRV_GENERIC_USB_CONTROLLER_HPP
 #define HEADER_XBOXDRV_GENERIC_USB_CONTROLLER_HPP
 
+#include <boost/scoped_ptr.hpp>
 #include <libusb.h>
+#include <vector>
 
 #include "controller_message.hpp"
 #include "controller/usb_controller.hpp"
+#include "report_parser.hpp"
 #include "xboxmsg.hpp"
 
 class GenericUSBController : public USBController
@@ -30,9 +33,13 @@ class GenericUSBController : public USBController
 private:
   int m_interface;
   int m_endpoint;
+  boost::scoped_ptr<ReportParser> m_parser;
+  int m_report_id; /// -1 if the reports carry no id
 
 public:
-  GenericUSBController(libusb_device* dev, int interface, int endpoint, bool try_detach);
+  GenericUSBController(libusb_device* dev, int interface, int endpoint,
+                       const std::vector<ReportField>& layout,
+                       bool try_detach);
   ~GenericUSBController();
 
   void set_rumble_real(uint8_t left, uint8_t right);
@@ -42,6 +49,10 @@ public:
 private:
   void print(libusb_config_descriptor* config, std::ostream& out) const;
 
+  /** Read and parse the HID report descriptor of \a intf, returns an
+      empty layout if the interface is not HID or has nothing usable */
+  std::vector<ReportField> read_hid_layout(const libusb_interface_descriptor& intf);
+
 private:
   GenericUSBController(const GenericUSBController&);
   GenericUSBController& operator=(const GenericUSBController&);
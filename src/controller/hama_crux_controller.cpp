@@ -87,6 +87,7 @@ HamaCruxController::HamaCruxController(libusb_device* dev, bool try_detach) :
 
 HamaCruxController::~HamaCruxController()
 {
+  usb_close();
 }
 
 void
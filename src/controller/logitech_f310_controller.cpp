@@ -32,12 +32,20 @@ LogitechF310Controller::LogitechF310Controller(libusb_device* dev, bool try_deta
   right_rumble(-1),
   xbox(m_message_descriptor)
 {
+  m_message_descriptor.set_abs_range(xbox.abs_x1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_x2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_lt, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_rt, 0, 255);
+
   usb_claim_interface(0, try_detach);
   usb_submit_read(1, 32);
 }
 
 LogitechF310Controller::~LogitechF310Controller()
 {
+  usb_close();
 }
 
 void
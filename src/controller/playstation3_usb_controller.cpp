@@ -34,12 +34,22 @@ Playstation3USBController::Playstation3USBController(libusb_device* dev, bool tr
   endpoint_out(2),
   xbox(m_message_descriptor)
 {
+  m_message_descriptor.set_abs_range(xbox.abs_x1, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_y1, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_x2, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_y2, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_a, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_b, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_x, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_y, 0, 255);
+
   usb_claim_interface(0, try_detach);
   usb_submit_read(endpoint_in, 64);
 }
 
 Playstation3USBController::~Playstation3USBController()
 {
+  usb_close();
 }
 
 #define HID_GET_REPORT      0x01
@@ -68,11 +78,11 @@ Playstation3USBController::set_rumble_real(uint8_t left, uint8_t right)
     0x00, 0x00, 0x00, 0x00, 0x00
   };
   
-  usb_control(LIBUSB_ENDPOINT_OUT | LIBUSB_REQUEST_TYPE_CLASS | LIBUSB_RECIPIENT_INTERFACE, // RequestType
-              HID_SET_REPORT,   // Request
-              (HID_REPORT_TYPE_OUTPUT << 8) | 0x01, // Value
-              0,   // Index
-              cmd, sizeof(cmd));
+  usb_control_coalesced(kOutputRumble, LIBUSB_ENDPOINT_OUT | LIBUSB_REQUEST_TYPE_CLASS | LIBUSB_RECIPIENT_INTERFACE, // RequestType
+                        HID_SET_REPORT,   // Request
+                        (HID_REPORT_TYPE_OUTPUT << 8) | 0x01, // Value
+                        0,   // Index
+                        cmd, sizeof(cmd));
 }
 
 void
@@ -123,11 +133,11 @@ Playstation3USBController::set_led_real(uint8_t status)
     0x00, 0x00, 0x00, 0x00, 0x00
   };
   
-  usb_control(LIBUSB_ENDPOINT_OUT | LIBUSB_REQUEST_TYPE_CLASS | LIBUSB_RECIPIENT_INTERFACE, // RequestType
-              HID_SET_REPORT,   // Request
-              (HID_REPORT_TYPE_OUTPUT << 8) | 0x01, // Value
-              0,   // Index
-              cmd, sizeof(cmd));
+  usb_control_coalesced(kOutputLED, LIBUSB_ENDPOINT_OUT | LIBUSB_REQUEST_TYPE_CLASS | LIBUSB_RECIPIENT_INTERFACE, // RequestType
+                        HID_SET_REPORT,   // Request
+                        (HID_REPORT_TYPE_OUTPUT << 8) | 0x01, // Value
+                        0,   // Index
+                        cmd, sizeof(cmd));
 }
 
 #define bitswap(x) x = ((x & 0x00ff) << 8) | ((x & 0xff00) >> 8)
@@ -0,0 +1,187 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "controller/replay_controller.hpp"
+
+#include "controller/usb_controller.hpp"
+#include "controller_message.hpp"
+#include "log.hpp"
+#include "usb_trace_writer.hpp"
+
+namespace {
+
+/** number of reports handled per main loop iteration when replaying
+    as fast as possible, so the rest of the main loop isn't starved */
+const int kFastBatchSize = 64;
+
+} // namespace
+
+ReplayController::ReplayController(const std::string& filename,
+                                   const boost::shared_ptr<USBController>& parser,
+                                   int busnum, int devnum, int endpoint,
+                                   bool realtime) :
+  m_parser(parser),
+  m_reader(filename),
+  m_busnum(busnum),
+  m_devnum(devnum),
+  m_endpoint(endpoint),
+  m_realtime(realtime),
+  m_record(),
+  m_have_record(false),
+  m_msg_slot(),
+  m_first_timestamp(0),
+  m_start_time(0),
+  m_count(0),
+  m_source_id(0)
+{
+  m_have_record = read_next();
+  if (!m_have_record)
+  {
+    log_warn(filename << ": no matching records in USB trace");
+  }
+  m_first_timestamp = m_record.timestamp;
+
+  // start from the main loop, so the callbacks are set up by then
+  m_source_id = g_idle_add(&ReplayController::on_timeout_wrap, this);
+}
+
+ReplayController::~ReplayController()
+{
+  if (m_source_id)
+  {
+    g_source_remove(m_source_id);
+  }
+}
+
+void
+ReplayController::set_rumble_real(uint8_t left, uint8_t right)
+{
+  // the parser is offline, nothing to send
+}
+
+void
+ReplayController::set_led_real(uint8_t status)
+{
+}
+
+const ControllerMessageDescriptor&
+ReplayController::get_message_descriptor()
+{
+  // messages are created by the parser, so they follow its layout
+  return m_parser->get_message_descriptor();
+}
+
+std::string
+ReplayController::get_usbpath() const
+{
+  return m_parser->get_usbpath();
+}
+
+std::string
+ReplayController::get_usbid() const
+{
+  return m_parser->get_usbid();
+}
+
+std::string
+ReplayController::get_name() const
+{
+  return "USB trace replay";
+}
+
+bool
+ReplayController::read_next()
+{
+  while (m_reader.read(&m_record))
+  {
+    if (m_record.type == USBTraceWriter::kRecordIn &&
+        (m_busnum   == -1 || m_busnum   == m_record.busnum) &&
+        (m_devnum   == -1 || m_devnum   == m_record.devnum) &&
+        (m_endpoint == -1 || m_endpoint == (m_record.endpoint & LIBUSB_ENDPOINT_ADDRESS_MASK)))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+gint64
+ReplayController::get_record_time(const USBTraceRecord& record) const
+{
+  return m_start_time + static_cast<gint64>(record.timestamp - m_first_timestamp);
+}
+
+void
+ReplayController::replay(const USBTraceRecord& record)
+{
+  ControllerMessage& msg = m_msg_slot.begin();
+  if (m_parser->parse(record.data.empty() ? 0 : &record.data[0], static_cast<int>(record.data.size()), &msg))
+  {
+    // stamp with the recorded time, so filters and modifiers see the
+    // original deltas even when replaying as fast as possible
+    msg.set_time(get_record_time(record));
+    submit_msg(m_msg_slot.commit(), get_message_descriptor());
+  }
+  m_count += 1;
+}
+
+bool
+ReplayController::on_timeout()
+{
+  m_source_id = 0;
+
+  if (m_start_time == 0)
+  {
+    m_start_time = g_get_monotonic_time();
+  }
+
+  int batch = 0;
+  while (m_have_record)
+  {
+    if (m_realtime)
+    {
+      const gint64 due = get_record_time(m_record);
+      const gint64 now = g_get_monotonic_time();
+      if (due > now)
+      {
+        m_source_id = g_timeout_add(static_cast<guint>((due - now + 999) / 1000),
+                                    &ReplayController::on_timeout_wrap, this);
+        return false;
+      }
+    }
+    else if (batch == kFastBatchSize)
+    {
+      m_source_id = g_idle_add(&ReplayController::on_timeout_wrap, this);
+      return false;
+    }
+
+    replay(m_record);
+    batch += 1;
+
+    m_have_record = read_next();
+  }
+
+  const gint64 duration = g_get_monotonic_time() - m_start_time;
+  log_info("replay finished: " << m_count << " reports in " << duration / 1000 << " msec");
+
+  send_disconnect();
+  return false;
+}
+
+/* EOF */
@@ -0,0 +1,96 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_CONTROLLER_REPLAY_CONTROLLER_HPP
+#define HEADER_XBOXDRV_CONTROLLER_REPLAY_CONTROLLER_HPP
+
+#include <boost/shared_ptr.hpp>
+#include <glib.h>
+#include <string>
+
+#include "controller.hpp"
+#include "controller_message_slot.hpp"
+#include "usb_trace_reader.hpp"
+
+class USBController;
+
+/** Feeds the IN reports of a trace recorded with --usb-trace through
+    the parse() function of an offline USBController, either with the
+    original timing or as fast as possible */
+class ReplayController : public Controller
+{
+private:
+  boost::shared_ptr<USBController> m_parser;
+  USBTraceReader m_reader;
+
+  int m_busnum;
+  int m_devnum;
+  int m_endpoint;
+  bool m_realtime;
+
+  USBTraceRecord m_record;
+  bool m_have_record;
+
+  ControllerMessageSlot m_msg_slot;
+
+  uint64_t m_first_timestamp;
+  gint64   m_start_time;
+  int      m_count;
+
+  guint m_source_id;
+
+public:
+  /** \a busnum, \a devnum and \a endpoint select the records to
+      replay, -1 matches everything */
+  ReplayController(const std::string& filename,
+                   const boost::shared_ptr<USBController>& parser,
+                   int busnum, int devnum, int endpoint,
+                   bool realtime);
+  ~ReplayController();
+
+  void set_rumble_real(uint8_t left, uint8_t right);
+  void set_led_real(uint8_t status);
+
+  const ControllerMessageDescriptor& get_message_descriptor();
+
+  std::string get_usbpath() const;
+  std::string get_usbid() const;
+  std::string get_name() const;
+
+private:
+  bool read_next();
+
+  /** Maps the timestamp of \a record onto the monotonic clock, the
+      first record is at m_start_time */
+  gint64 get_record_time(const USBTraceRecord& record) const;
+  void replay(const USBTraceRecord& record);
+
+  bool on_timeout();
+  static gboolean on_timeout_wrap(gpointer data) {
+    return static_cast<ReplayController*>(data)->on_timeout();
+  }
+
+private:
+  ReplayController(const ReplayController&);
+  ReplayController& operator=(const ReplayController&);
+};
+
+#endif
+
+/* EOF */
@@ -63,12 +63,18 @@ SaitekP2500Controller::SaitekP2500Controller(libusb_device* dev, bool try_detach
   right_rumble(-1),
   xbox(m_message_descriptor)
 {
+  m_message_descriptor.set_abs_range(xbox.abs_x1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_x2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y2, -32768, 32767);
+
   usb_claim_interface(0, try_detach);
   usb_submit_read(1, sizeof(SaitekP2500Msg));
 }
 
 SaitekP2500Controller::~SaitekP2500Controller()
 {
+  usb_close();
 }
 
 void
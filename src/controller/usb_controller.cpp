@@ -18,158 +18,328 @@
 
 #include "controller/usb_controller.hpp"
 
+#include <algorithm>
+#include <boost/bind.hpp>
 #include <boost/format.hpp>
+#include <boost/ref.hpp>
+#include <new>
 
 #include "controller_message.hpp"
+#include "controller_message_queue.hpp"
 #include "log.hpp"
 #include "raise_exception.hpp"
 #include "usb_helper.hpp"
+#include "usb_trace_writer.hpp"
 #include "xboxmsg.hpp"
 
-USBController::USBController(libusb_device* dev) :
-  m_dev(dev),
-  m_handle(0),
-  m_transfers(),
-  m_interfaces(),
-  m_usbpath(),
-  m_usbid(),
-  m_name()  
+int USBController::s_read_queue_depth = 2;
+bool USBController::s_event_thread = false;
+USBTraceWriter* USBController::s_trace_writer = 0;
+
+void
+USBController::set_event_thread(bool v)
 {
-  int ret = libusb_open(dev, &m_handle);
-  if (ret != LIBUSB_SUCCESS)
+  s_event_thread = v;
+}
+
+void
+USBController::set_trace_writer(USBTraceWriter* writer)
+{
+  s_trace_writer = writer;
+}
+
+void
+USBController::set_read_queue_depth(int depth)
+{
+  if (depth < 1)
   {
-    raise_exception(std::runtime_error, "libusb_open() failed: " << usb_strerror(ret));
+    raise_exception(std::runtime_error, "read queue depth must be 1 or larger: " << depth);
   }
   else
-  { 
-    // get usbpath, usbid and name
-    m_usbpath = (boost::format("%03d:%03d") 
-                 % static_cast<int>(libusb_get_bus_number(dev))
-                 % static_cast<int>(libusb_get_device_address(dev))).str();
-
-    libusb_device_descriptor desc;
-    ret = libusb_get_device_descriptor(dev, &desc);
-    if (ret == LIBUSB_SUCCESS)
-    {
-      m_usbid = (boost::format("%04x:%04x") 
-                 % static_cast<int>(desc.idVendor) 
-                 % static_cast<int>(desc.idProduct)).str();
-  
-      char buf[1024];
-      int len;
-      if (false)
-      { // FIXME: do we need the manufacturer name?
-        len = libusb_get_string_descriptor_ascii(m_handle, desc.iManufacturer,
-                                                 reinterpret_cast<unsigned char*>(buf), sizeof(buf));
-        if (len > 0)
-        {
-          m_name.append(buf, len);
-          m_name.append(" ");
-        }
-      }
+  {
+    s_read_queue_depth = depth;
+  }
+}
 
-      len = libusb_get_string_descriptor_ascii(m_handle, desc.iProduct, 
-                                               reinterpret_cast<unsigned char*>(buf), sizeof(buf));
-      if (len > 0)
-      {
-        m_name.append(buf, len);
-      }
-    }
+USBController::USBController(libusb_device* dev) :
+  m_device(dev ? new USBDeviceHandle(dev) : 0),
+  m_dev(dev),
+  m_handle(m_device ? m_device->get_handle() : 0),
+  m_mutex(),
+  m_msg_queue(),
+  m_msg_slot(),
+  m_transfers(),
+  m_read_queues(),
+  m_completed_reads(),
+  m_read_queue_depth(s_read_queue_depth),
+  m_trace(s_trace_writer),
+  m_transfer_pool(64, 4), // room for the 8 byte setup packet plus payload
+  m_output(),
+  m_closing(false)
+{
+  init();
+}
+
+USBController::USBController(const USBDeviceHandlePtr& device) :
+  m_device(device),
+  m_dev(m_device->get_device()),
+  m_handle(m_device->get_handle()),
+  m_mutex(),
+  m_msg_queue(),
+  m_msg_slot(),
+  m_transfers(),
+  m_read_queues(),
+  m_completed_reads(),
+  m_read_queue_depth(s_read_queue_depth),
+  m_trace(s_trace_writer),
+  m_transfer_pool(64, 4),
+  m_output(),
+  m_closing(false)
+{
+  init();
+}
+
+void
+USBController::init()
+{
+  pthread_mutex_init(&m_mutex, NULL);
+
+  if (s_event_thread)
+  {
+    m_msg_queue.reset(new ControllerMessageQueue(64, boost::bind(&Controller::submit_msg, this, _1,
+                                                                 boost::cref(m_message_descriptor))));
   }
 }
 
 USBController::~USBController()
+{
+  // subclasses should have done this already, but make sure no
+  // transfer outlives the controller
+  usb_close();
+
+  pthread_mutex_destroy(&m_mutex);
+}
+
+void
+USBController::usb_close()
 {
   // cancel all transfers
-  for(std::set<libusb_transfer*>::iterator it = m_transfers.begin(); it != m_transfers.end(); ++it)
   {
-    libusb_cancel_transfer(*it);
+    Lock lock(m_mutex);
+
+    if (m_closing)
+    {
+      return;
+    }
+    m_closing = true;
+
+    // completed reads that wait for an older one aren't in flight
+    // anymore, so there is no callback left to free them
+    for(std::set<libusb_transfer*>::iterator it = m_completed_reads.begin(); it != m_completed_reads.end(); ++it)
+    {
+      free_read(*it);
+    }
+    m_completed_reads.clear();
+
+    for(std::set<libusb_transfer*>::iterator it = m_transfers.begin(); it != m_transfers.end(); ++it)
+    {
+      libusb_cancel_transfer(*it);
+    }
   }
 
   // wait for cancel to succeed
-  while (!m_transfers.empty()) 
+  while (true)
   {
-    int ret = libusb_handle_events(NULL);
+    {
+      Lock lock(m_mutex);
+      if (m_transfers.empty())
+      {
+        break;
+      }
+    }
+
+    // with --usb-thread the completions might get handled over
+    // there, so don't block for long
+    struct timeval tv = { 0, 100 * 1000 };
+    int ret = libusb_handle_events_timeout(NULL, &tv);
     if (ret != 0)
     {
-      log_error("libusb_handle_events() failure: " << ret);
+      log_error("libusb_handle_events_timeout() failure: " << ret);
     }
   }
 
-  // release all claimed interfaces
-  for(std::set<int>::iterator it = m_interfaces.begin(); it != m_interfaces.end(); ++it)
+  // drop payloads that never made it onto the bus
+  Lock lock(m_mutex);
+  for(int i = 0; i < kOutputChannelCount; ++i)
   {
-    libusb_release_interface(m_handle, *it);
+    if (m_output[i].queued)
+    {
+      m_transfer_pool.release(m_output[i].queued);
+      m_output[i].queued = 0;
+    }
   }
 
-  // read and write transfers might still be going on and might need to be canceled
-  libusb_close(m_handle);
+  // claimed interfaces are released and the device closed once the
+  // last controller using m_device is gone
 }
 
 std::string
 USBController::get_usbpath() const
 {
-  return m_usbpath;
+  if (!m_device)
+  {
+    return Controller::get_usbpath();
+  }
+  else
+  {
+    return m_device->get_usbpath();
+  }
 }
 
 std::string
 USBController::get_usbid() const
 {
-  return m_usbid;
+  if (!m_device)
+  {
+    return Controller::get_usbid();
+  }
+  else
+  {
+    return m_device->get_usbid();
+  }
 }
 
 std::string
 USBController::get_name() const
 {
-  return m_name;
+  if (!m_device)
+  {
+    return Controller::get_name();
+  }
+  else
+  {
+    return m_device->get_name();
+  }
 }
 
 void
 USBController::usb_submit_read(int endpoint, int len)
 {
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
+  if (!m_handle)
+  {
+    return; // offline
+  }
 
-  uint8_t* data = static_cast<uint8_t*>(malloc(sizeof(uint8_t) * len));
-  transfer->flags |= LIBUSB_TRANSFER_FREE_BUFFER;
-  libusb_fill_interrupt_transfer(transfer, m_handle,
-                                 static_cast<unsigned char>(endpoint | LIBUSB_ENDPOINT_IN),
-                                 data, len,
-                                 &USBController::on_read_data_wrap, this,
-                                 0); // timeout
-  int ret;
-  ret = libusb_submit_transfer(transfer);
-  if (ret != LIBUSB_SUCCESS)
+  Lock lock(m_mutex);
+
+  std::deque<libusb_transfer*>& queue = m_read_queues[endpoint];
+  std::vector<libusb_transfer*> submitted;
+
+  try
   {
-    libusb_free_transfer(transfer);
-    raise_exception(std::runtime_error, "libusb_submit_transfer(): " << usb_strerror(ret));
+    for(int i = 0; i < m_read_queue_depth; ++i)
+    {
+      libusb_transfer* transfer = libusb_alloc_transfer(0);
+      if (!transfer)
+      {
+        throw std::bad_alloc();
+      }
+
+      uint8_t* data = static_cast<uint8_t*>(malloc(sizeof(uint8_t) * len));
+      if (!data)
+      {
+        libusb_free_transfer(transfer);
+        throw std::bad_alloc();
+      }
+
+      transfer->flags |= LIBUSB_TRANSFER_FREE_BUFFER;
+      libusb_fill_interrupt_transfer(transfer, m_handle,
+                                     static_cast<unsigned char>(endpoint | LIBUSB_ENDPOINT_IN),
+                                     data, len,
+                                     &USBController::on_read_data_wrap, this,
+                                     0); // timeout
+      int ret;
+      ret = libusb_submit_transfer(transfer);
+      if (ret != LIBUSB_SUCCESS)
+      {
+        libusb_free_transfer(transfer);
+        raise_exception(std::runtime_error, "libusb_submit_transfer(): " << usb_strerror(ret));
+      }
+      else
+      {
+        m_transfers.insert(transfer);
+        queue.push_back(transfer);
+        submitted.push_back(transfer);
+      }
+    }
   }
-  else
+  catch(...)
   {
-    m_transfers.insert(transfer);
+    // don't leave the reads of this call running, taking them out of
+    // the queue makes on_read_data() free them once the cancel went
+    // through, they stay in m_transfers until then
+    for(std::vector<libusb_transfer*>::iterator it = submitted.begin(); it != submitted.end(); ++it)
+    {
+      queue.erase(std::find(queue.begin(), queue.end(), *it));
+      libusb_cancel_transfer(*it);
+    }
+    throw;
   }
 }
 
-void
-USBController::usb_write(int endpoint, uint8_t* data_in, int len)
+libusb_transfer*
+USBController::prepare_write(int endpoint, uint8_t* data_in, int len,
+                             libusb_transfer_cb_fn callback)
 {
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_BUFFER;
+  libusb_transfer* transfer;
+  { // the pool is shared with the completion callbacks in the USB thread
+    Lock lock(m_mutex);
+    transfer = m_transfer_pool.acquire(len);
+  }
 
-  // copy data into a newly allocated buffer
-  uint8_t* data = static_cast<uint8_t*>(malloc(sizeof(uint8_t) * len));
-  memcpy(data, data_in, len);
+  // copy data into the transfer's own buffer
+  memcpy(transfer->buffer, data_in, len);
 
   libusb_fill_interrupt_transfer(transfer, m_handle,
                                  static_cast<unsigned char>(endpoint | LIBUSB_ENDPOINT_OUT),
-                                 data, len,
-                                 &USBController::on_write_data_wrap, this,
+                                 transfer->buffer, len,
+                                 callback, this,
                                  0); // timeout
+  return transfer;
+}
+
+libusb_transfer*
+USBController::prepare_control(uint8_t  bmRequestType, uint8_t  bRequest,
+                               uint16_t wValue, uint16_t wIndex,
+                               uint8_t* data_in, uint16_t wLength,
+                               libusb_transfer_cb_fn callback)
+{
+  libusb_transfer* transfer;
+  {
+    Lock lock(m_mutex);
+    transfer = m_transfer_pool.acquire(wLength + 8);
+  }
+
+  // fill control buffer
+  uint8_t* data = transfer->buffer;
+  libusb_fill_control_setup(data, bmRequestType, bRequest, wValue, wIndex, wLength);
+  memcpy(data + 8, data_in, wLength);
+  libusb_fill_control_transfer(transfer, m_handle, data,
+                               callback, this, 
+                               0);
+  return transfer;
+}
+
+void
+USBController::submit_transfer(libusb_transfer* transfer)
+{
+  Lock lock(m_mutex);
 
   int ret;
   ret = libusb_submit_transfer(transfer);
   if (ret != LIBUSB_SUCCESS)
   {
-    libusb_free_transfer(transfer);
+    m_transfer_pool.release(transfer);
     raise_exception(std::runtime_error, "libusb_submit_transfer(): " << usb_strerror(ret));
   }
   else
@@ -178,33 +348,135 @@ USBController::usb_write(int endpoint, uint8_t* data_in, int len)
   }
 }
 
+void
+USBController::usb_write(int endpoint, uint8_t* data, int len)
+{
+  if (!m_handle)
+  {
+    return; // offline
+  }
+
+  submit_transfer(prepare_write(endpoint, data, len, &USBController::on_write_data_wrap));
+}
+
 void
 USBController::usb_control(uint8_t  bmRequestType, uint8_t  bRequest,
                            uint16_t wValue, uint16_t wIndex,
-                           uint8_t* data_in, uint16_t wLength)
+                           uint8_t* data, uint16_t wLength)
 {
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_BUFFER;
+  if (!m_handle)
+  {
+    return; // offline
+  }
 
-  // create and fill control buffer
-  uint8_t* data = static_cast<uint8_t*>(malloc(wLength + 8));
-  libusb_fill_control_setup(data, bmRequestType, bRequest, wValue, wIndex, wLength);
-  memcpy(data + 8, data_in, wLength);
-  libusb_fill_control_transfer(transfer, m_handle, data,
-                               &USBController::on_control_wrap, this, 
-                               0);
+  submit_transfer(prepare_control(bmRequestType, bRequest, wValue, wIndex, data, wLength,
+                                  &USBController::on_control_wrap));
+}
 
-  int ret;
-  ret = libusb_submit_transfer(transfer);
-  if (ret != LIBUSB_SUCCESS)
+void
+USBController::usb_write_coalesced(OutputChannel channel, int endpoint, uint8_t* data, int len)
+{
+  if (!m_handle)
   {
-    libusb_free_transfer(transfer);
-    raise_exception(std::runtime_error, "libusb_submit_transfer(): " << usb_strerror(ret));
+    return; // offline
+  }
+
+  submit_coalesced(channel, prepare_write(endpoint, data, len, &USBController::on_coalesced_data_wrap));
+}
+
+void
+USBController::usb_control_coalesced(OutputChannel channel,
+                                     uint8_t  bmRequestType, uint8_t  bRequest,
+                                     uint16_t wValue, uint16_t wIndex,
+                                     uint8_t* data, uint16_t wLength)
+{
+  if (!m_handle)
+  {
+    return; // offline
+  }
+
+  submit_coalesced(channel, prepare_control(bmRequestType, bRequest, wValue, wIndex, data, wLength,
+                                            &USBController::on_coalesced_data_wrap));
+}
+
+void
+USBController::submit_coalesced(OutputChannel channel, libusb_transfer* transfer)
+{
+  Lock lock(m_mutex);
+
+  OutputSlot& slot = m_output[channel];
+
+  if (slot.pending)
+  {
+    // the device is still busy with the previous value, replace
+    // whatever is waiting with the newest one
+    if (slot.queued)
+    {
+      m_transfer_pool.release(slot.queued);
+    }
+    slot.queued = transfer;
   }
   else
   {
-    m_transfers.insert(transfer);
+    int ret = libusb_submit_transfer(transfer);
+    if (ret != LIBUSB_SUCCESS)
+    {
+      m_transfer_pool.release(transfer);
+      raise_exception(std::runtime_error, "libusb_submit_transfer(): " << usb_strerror(ret));
+    }
+    else
+    {
+      m_transfers.insert(transfer);
+      slot.pending = transfer;
+    }
+  }
+}
+
+void
+USBController::on_coalesced_data(libusb_transfer* transfer)
+{
+  Lock lock(m_mutex);
+
+  if (transfer->status != LIBUSB_TRANSFER_COMPLETED)
+  {
+    if (transfer->status != LIBUSB_TRANSFER_CANCELLED)
+      log_error("USB write failure: " << transfer->length << ": " << usb_transfer_strerror(transfer->status));
+  }
+  else if (m_trace)
+  {
+    trace_transfer(transfer);
+  }
+
+  for(int i = 0; i < kOutputChannelCount; ++i)
+  {
+    OutputSlot& slot = m_output[i];
+    if (slot.pending == transfer)
+    {
+      slot.pending = 0;
+
+      if (slot.queued && transfer->status != LIBUSB_TRANSFER_CANCELLED && !m_closing)
+      {
+        libusb_transfer* next = slot.queued;
+        slot.queued = 0;
+
+        int ret = libusb_submit_transfer(next);
+        if (ret != LIBUSB_SUCCESS)
+        {
+          log_error("libusb_submit_transfer(): " << usb_strerror(ret));
+          m_transfer_pool.release(next);
+        }
+        else
+        {
+          m_transfers.insert(next);
+          slot.pending = next;
+        }
+      }
+      break;
+    }
   }
+
+  m_transfers.erase(transfer);
+  m_transfer_pool.release(transfer);
 }
 
 void
@@ -212,8 +484,14 @@ USBController::on_control(libusb_transfer* transfer)
 {
   log_debug("control transfer");
 
+  if (m_trace && transfer->status == LIBUSB_TRANSFER_COMPLETED)
+  {
+    trace_transfer(transfer);
+  }
+
+  Lock lock(m_mutex);
   m_transfers.erase(transfer);
-  libusb_free_transfer(transfer);
+  m_transfer_pool.release(transfer);
 }
 
 void
@@ -224,9 +502,14 @@ USBController::on_write_data(libusb_transfer* transfer)
     if (transfer->status != LIBUSB_TRANSFER_CANCELLED)
       log_error("USB write failure: " << transfer->length << ": " << usb_transfer_strerror(transfer->status));
   }
+  else if (m_trace)
+  {
+    trace_transfer(transfer);
+  }
 
+  Lock lock(m_mutex);
   m_transfers.erase(transfer);
-  libusb_free_transfer(transfer);
+  m_transfer_pool.release(transfer);
 }
 
 void
@@ -234,57 +517,176 @@ USBController::on_read_data(libusb_transfer* transfer)
 {
   assert(transfer);
 
-  if (transfer->status != LIBUSB_TRANSFER_COMPLETED)
+  const int endpoint = transfer->endpoint & LIBUSB_ENDPOINT_ADDRESS_MASK;
+
+  Lock lock(m_mutex);
+
+  std::deque<libusb_transfer*>& queue = m_read_queues[endpoint];
+
+  if (m_closing || std::find(queue.begin(), queue.end(), transfer) == queue.end())
+  {
+    // shutting down or given up on by usb_submit_read()
+    free_read(transfer);
+  }
+  else if (transfer->status != LIBUSB_TRANSFER_COMPLETED)
   {
     if (transfer->status != LIBUSB_TRANSFER_CANCELLED)
       log_error("USB read failure: " << transfer->length << ": " << usb_transfer_strerror(transfer->status));
 
-    m_transfers.erase(transfer);
-    libusb_free_transfer(transfer);
+    free_read(transfer);
   }
   else
   {
-    // process data
-    ControllerMessage msg;
-    if (parse(transfer->buffer, transfer->actual_length, &msg))
+    // libusb completes transfers on one endpoint in the order they
+    // were submitted, but we don't rely on it and only ever process
+    // the oldest transfer of the queue
+    m_completed_reads.insert(transfer);
+
+    if (m_trace)
+    {
+      trace_transfer(transfer);
+    }
+  }
+
+  while (!queue.empty() && m_completed_reads.erase(queue.front()))
+  {
+    libusb_transfer* head = queue.front();
+    queue.pop_front();
+
+    {
+      // parse() might issue writes of its own, so don't hold the lock
+      // while it runs
+      Unlock unlock(m_mutex);
+      try
+      {
+        process_read_data(head);
+      }
+      catch(const std::exception& err)
+      {
+        // this runs from within libusb, don't let it unwind through it
+        log_error("failed to process USB data: " << err.what());
+      }
+    }
+
+    if (m_closing)
+    {
+      // usb_close() came in while the lock was released
+      free_read(head);
+    }
+    else
     {
-      submit_msg(msg, m_message_descriptor);
+      resubmit_read(head);
     }
+  }
+}
 
-    int ret;
-    ret = libusb_submit_transfer(transfer);
-    if (ret != LIBUSB_SUCCESS) // could also check for LIBUSB_ERROR_NO_DEVICE
+void
+USBController::free_read(libusb_transfer* transfer)
+{
+  std::deque<libusb_transfer*>& queue = m_read_queues[transfer->endpoint & LIBUSB_ENDPOINT_ADDRESS_MASK];
+  std::deque<libusb_transfer*>::iterator it = std::find(queue.begin(), queue.end(), transfer);
+  if (it != queue.end())
+  {
+    queue.erase(it);
+  }
+
+  m_transfers.erase(transfer);
+  libusb_free_transfer(transfer);
+}
+
+void
+USBController::process_read_data(libusb_transfer* transfer)
+{
+  // taken as close to the transfer completion as possible, with
+  // --usb-thread the message reaches the main loop a bit later
+  const gint64 now = g_get_monotonic_time();
+
+  // process data, the message is parsed in place into the buffer
+  // that is handed on, no copy is taken on the way
+  if (m_msg_queue)
+  {
+    ControllerMessage* msg = m_msg_queue->begin_push();
+    if (msg && parse(transfer->buffer, transfer->actual_length, msg))
+    {
+      msg->set_time(now);
+      m_msg_queue->commit_push();
+    }
+  }
+  else
+  {
+    ControllerMessage& msg = m_msg_slot.begin();
+    if (parse(transfer->buffer, transfer->actual_length, &msg))
     {
-      log_error("failed to resubmit USB transfer: " << usb_strerror(ret));
+      msg.set_time(now);
+      submit_msg(m_msg_slot.commit(), m_message_descriptor);
+    }
+  }
+}
 
-      libusb_free_transfer(transfer);
+void
+USBController::resubmit_read(libusb_transfer* transfer)
+{
+  int ret;
+  ret = libusb_submit_transfer(transfer);
+  if (ret != LIBUSB_SUCCESS) // could also check for LIBUSB_ERROR_NO_DEVICE
+  {
+    log_error("failed to resubmit USB transfer: " << usb_strerror(ret));
 
+    m_transfers.erase(transfer);
+    libusb_free_transfer(transfer);
+
+    // with multiple transfers in flight every one of them will fail,
+    // only report the disconnect once
+    if (!m_is_disconnected)
+    {
       send_disconnect();
     }
   }
+  else
+  {
+    m_read_queues[transfer->endpoint & LIBUSB_ENDPOINT_ADDRESS_MASK].push_back(transfer);
+  }
 }
 
 void
-USBController::usb_claim_interface(int ifnum, bool try_detach)
+USBController::trace_transfer(libusb_transfer* transfer)
 {
-  // keep track of all claimed interfaces so they can be released in
-  // the destructor
-  assert(m_interfaces.find(ifnum) == m_interfaces.end());
-  m_interfaces.insert(ifnum);
+  const uint8_t busnum = libusb_get_bus_number(m_dev);
+  const uint8_t devnum = libusb_get_device_address(m_dev);
 
-  int err = usb_claim_n_detach_interface(m_handle, ifnum, try_detach);
-  if (err != 0) 
+  if (transfer->type == LIBUSB_TRANSFER_TYPE_CONTROL)
   {
-    std::ostringstream out;
-    out << " Error couldn't claim the USB interface: " << usb_strerror(err) << std::endl
-        << "Try to run 'rmmod xpad' and then xboxdrv again or start xboxdrv with the option --detach-kernel-driver.";
-    throw std::runtime_error(out.str());
+    // keep the setup packet, it tells what the request was
+    m_trace->record(USBTraceWriter::kRecordControl, busnum, devnum, 0,
+                    transfer->buffer, LIBUSB_CONTROL_SETUP_SIZE + transfer->actual_length);
+  }
+  else
+  {
+    m_trace->record((transfer->endpoint & LIBUSB_ENDPOINT_DIR_MASK) == LIBUSB_ENDPOINT_IN ? 
+                    USBTraceWriter::kRecordIn : USBTraceWriter::kRecordOut,
+                    busnum, devnum, transfer->endpoint,
+                    transfer->buffer, transfer->actual_length);
+  }
+}
+
+void
+USBController::usb_claim_interface(int ifnum, bool try_detach)
+{
+  if (m_device)
+  {
+    m_device->claim_interface(ifnum, try_detach);
   }
 }
 
 int
 USBController::usb_find_ep(int direction, uint8_t if_class, uint8_t if_subclass, uint8_t if_protocol)
 {
+  if (!m_dev)
+  {
+    // offline, there is nothing to search, the endpoint isn't used anyway
+    return -1;
+  }
+
   libusb_config_descriptor* config;
   int ret = libusb_get_config_descriptor(m_dev, 0 /* config_index */, &config);
 
@@ -19,29 +19,101 @@
 #ifndef HEADER_XBOXDRV_USB_CONTROLLER_HPP
 #define HEADER_XBOXDRV_USB_CONTROLLER_HPP
 
+#include <boost/scoped_ptr.hpp>
 #include <libusb.h>
+#include <deque>
+#include <map>
+#include <pthread.h>
 #include <string>
 #include <memory>
 #include <set>
 
 #include "controller.hpp"
+#include "controller_message_slot.hpp"
+#include "usb_device_handle.hpp"
+#include "usb_transfer_pool.hpp"
+
+class ControllerMessageQueue;
+class USBTraceWriter;
 
 class USBController : public Controller
 {
+public:
+  /** Output channels for which at most one transfer is kept in
+      flight, see usb_write_coalesced() */
+  enum OutputChannel {
+    kOutputRumble,
+    kOutputLED,
+    kOutputChannelCount
+  };
+
 protected:
+  /** possibly shared with other controllers on the same device */
+  USBDeviceHandlePtr m_device;
   libusb_device* m_dev;
   libusb_device_handle* m_handle;
 
+  /** guards the transfer bookkeeping below, with set_event_thread()
+      the libusb callbacks run in a different thread then the one
+      issuing writes */
+  pthread_mutex_t m_mutex;
+
+  /** only used with set_event_thread(), hands parsed messages over to
+      the main loop */
+  boost::scoped_ptr<ControllerMessageQueue> m_msg_queue;
+
+  /** without set_event_thread() parse() writes into this slot, the
+      last submitted message stays valid until the next one */
+  ControllerMessageSlot m_msg_slot;
+
   std::set<libusb_transfer*> m_transfers;
-  std::set<int> m_interfaces;
 
-  std::string m_usbpath;
-  std::string m_usbid;
-  std::string m_name;
+  /** read transfers currently in flight for each IN endpoint, in the
+      order in which they were submitted */
+  std::map<int, std::deque<libusb_transfer*> > m_read_queues;
+
+  /** read transfers that have completed, but are still waiting for
+      an older transfer on the same endpoint to be processed */
+  std::set<libusb_transfer*> m_completed_reads;
+
+  int m_read_queue_depth;
+
+  /** records all completed transfers when set, see set_trace_writer() */
+  USBTraceWriter* m_trace;
+
+  /** recycled transfers for usb_write() and usb_control(), guarded
+      by m_mutex as transfers are released from the USB thread */
+  USBTransferPool m_transfer_pool;
+
+  struct OutputSlot
+  {
+    libusb_transfer* pending; /// transfer currently in flight
+    libusb_transfer* queued;  /// newest payload, submitted once pending completes
+  };
+  OutputSlot m_output[kOutputChannelCount];
+
+  /** set by usb_close(), completed transfers are then freed instead
+      of being processed or resubmitted, guarded by m_mutex */
+  bool m_closing;
 
 public:
+  /** \a dev may be NULL, the controller is then offline: no device is
+      opened, all USB I/O is skipped and only parse() is of use, see
+      ReplayController */
   USBController(libusb_device* dev);
+
+  /** Creates a controller on an already opened device, used when a
+      single device carries multiple controllers */
+  USBController(const USBDeviceHandlePtr& device);
   virtual ~USBController();
+
+  /** Cancels all transfers and waits for them to be gone, afterwards
+      no libusb callback will touch the controller anymore. Every
+      subclass has to call this first thing in its destructor, as
+      with --usb-thread a completing transfer would otherwise call
+      parse() on a half destroyed object. Calling it more than once
+      is harmless. */
+  void usb_close();
   
   virtual std::string get_usbpath() const;
   virtual std::string get_usbid() const;
@@ -49,10 +121,28 @@ public:
 
   virtual bool parse(const uint8_t* data, int len, ControllerMessage* msg_out) =0;
 
+  /** Sets the number of read transfers that are kept in flight per
+      endpoint for all USBControllers created afterwards */
+  static void set_read_queue_depth(int depth);
+
+  /** Tells USBControllers created afterwards that libusb events are
+      handled in a separate thread, parsed messages will then be
+      queued and delivered from the glib main loop */
+  static void set_event_thread(bool v);
+
+  /** Completed transfers of USBControllers created afterwards get
+      recorded into \a writer, NULL disables recording, the writer
+      must outlive the controllers */
+  static void set_trace_writer(USBTraceWriter* writer);
+
   int  usb_find_ep(int direction, uint8_t if_class, uint8_t if_subclass, uint8_t if_protocol);
 
   void usb_claim_interface(int ifnum, bool try_detach);
 
+  /** Submits read transfers for \a endpoint, the number of transfers
+      kept in flight is given by the read queue depth, so the host
+      controller always has a buffer posted while the previous one is
+      being processed */
   void usb_submit_read(int endpoint, int len);
 
   void usb_write(int endpoint, uint8_t* data, int len);
@@ -60,7 +150,67 @@ public:
                    uint16_t wValue, uint16_t wIndex,
                    uint8_t* data, uint16_t len);
 
+  /** Like usb_write(), but keeps at most one transfer per \a channel
+      in flight. Writes issued while a transfer is pending replace the
+      queued payload, so only the newest value is send once the
+      pending transfer completes. */
+  void usb_write_coalesced(OutputChannel channel, int endpoint, uint8_t* data, int len);
+  void usb_control_coalesced(OutputChannel channel,
+                             uint8_t bmRequestType, uint8_t  bRequest,
+                             uint16_t wValue, uint16_t wIndex,
+                             uint8_t* data, uint16_t len);
+
 private:
+  static int s_read_queue_depth;
+  static bool s_event_thread;
+  static USBTraceWriter* s_trace_writer;
+
+  void init();
+
+  class Lock
+  {
+  private:
+    pthread_mutex_t& m_mutex;
+
+  public:
+    Lock(pthread_mutex_t& mutex) : m_mutex(mutex) { pthread_mutex_lock(&m_mutex); }
+    ~Lock() { pthread_mutex_unlock(&m_mutex); }
+
+  private:
+    Lock(const Lock&);
+    Lock& operator=(const Lock&);
+  };
+
+  /** The reverse of Lock, releases an already held mutex for the
+      lifetime of the object */
+  class Unlock
+  {
+  private:
+    pthread_mutex_t& m_mutex;
+
+  public:
+    Unlock(pthread_mutex_t& mutex) : m_mutex(mutex) { pthread_mutex_unlock(&m_mutex); }
+    ~Unlock() { pthread_mutex_lock(&m_mutex); }
+
+  private:
+    Unlock(const Unlock&);
+    Unlock& operator=(const Unlock&);
+  };
+
+  void process_read_data(libusb_transfer* transfer);
+  void resubmit_read(libusb_transfer* transfer);
+  void free_read(libusb_transfer* transfer);
+  void trace_transfer(libusb_transfer* transfer);
+
+  libusb_transfer* prepare_write(int endpoint, uint8_t* data, int len,
+                                 libusb_transfer_cb_fn callback);
+  libusb_transfer* prepare_control(uint8_t bmRequestType, uint8_t  bRequest,
+                                   uint16_t wValue, uint16_t wIndex,
+                                   uint8_t* data, uint16_t len,
+                                   libusb_transfer_cb_fn callback);
+  void submit_transfer(libusb_transfer* transfer);
+  void submit_coalesced(OutputChannel channel, libusb_transfer* transfer);
+
   void on_read_data(libusb_transfer *transfer);
   static void on_read_data_wrap(libusb_transfer *transfer)
   {
@@ -79,6 +229,12 @@ private:
     static_cast<USBController*>(transfer->user_data)->on_control(transfer);
   }
 
+  void on_coalesced_data(libusb_transfer* transfer);
+  static void on_coalesced_data_wrap(libusb_transfer* transfer)
+  {
+    static_cast<USBController*>(transfer->user_data)->on_coalesced_data(transfer);
+  }
+
 private:
   USBController(const USBController&);
   USBController& operator=(const USBController&);
@@ -124,6 +124,7 @@ WiimoteController::WiimoteController() :
   m_mutex(),
   m_wiimote(),
   m_ctrl_msg(),
+  m_msg_slot(),
   m_wiimote_zero(),
   m_wiimote_one(),
   m_nunchuk_zero(),
@@ -357,7 +358,7 @@ WiimoteController::on_button(const cwiid_btn_mesg& msg)
   m_ctrl_msg.set_key(wiimote.dpad_down,  msg.buttons & CWIID_BTN_DOWN);
   m_ctrl_msg.set_key(wiimote.dpad_up,    msg.buttons & CWIID_BTN_UP);
 
-  submit_msg(m_ctrl_msg, m_message_descriptor);
+  submit_msg(m_msg_slot.commit(m_ctrl_msg), m_message_descriptor);
 }
 
 void
@@ -367,7 +368,7 @@ WiimoteController::on_acc(const cwiid_acc_mesg& msg)
   m_ctrl_msg.set_abs(wiimote.acc_y, msg.acc[1], 0, 255);
   m_ctrl_msg.set_abs(wiimote.acc_z, msg.acc[2], 0, 255);
 
-  submit_msg(m_ctrl_msg, m_message_descriptor);
+  submit_msg(m_msg_slot.commit(m_ctrl_msg), m_message_descriptor);
 }
 
 void
@@ -416,7 +417,7 @@ WiimoteController::on_ir(const cwiid_ir_mesg& msg)
   else
     m_ctrl_msg.set_abs(wiimote.ir4_size, -1, -128, 127);
 
-  submit_msg(m_ctrl_msg, m_message_descriptor);
+  submit_msg(m_msg_slot.commit(m_ctrl_msg), m_message_descriptor);
 }
 
 // FIXME: use proper CalibrationAxisFilter instead of this hack, also CalibrationAxisFilter doesn't handle min/max properly
@@ -452,7 +453,7 @@ WiimoteController::on_nunchuk(const cwiid_nunchuk_mesg& msg)
   m_ctrl_msg.set_key(wiimote.nunchuk_z, msg.buttons & CWIID_NUNCHUK_BTN_Z);
   m_ctrl_msg.set_key(wiimote.nunchuk_c, msg.buttons & CWIID_NUNCHUK_BTN_C);
 
-  submit_msg(m_ctrl_msg, m_message_descriptor);
+  submit_msg(m_msg_slot.commit(m_ctrl_msg), m_message_descriptor);
 }
 
 void
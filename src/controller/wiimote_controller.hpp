@@ -26,6 +26,7 @@
 
 #include "controller.hpp"
 #include "controller_message.hpp"
+#include "controller_message_slot.hpp"
 
 class ControllerMessageDescriptor;
 
@@ -98,8 +99,12 @@ private:
   pthread_mutex_t  m_mutex;
   cwiid_wiimote_t* m_wiimote;
 
+  /** the state built up from the cwiid messages */
   ControllerMessage m_ctrl_msg;
 
+  /** the submitted copies of m_ctrl_msg, see submit_msg() */
+  ControllerMessageSlot m_msg_slot;
+
   AccCalibration m_wiimote_zero;
   AccCalibration m_wiimote_one;
 
@@ -43,6 +43,13 @@ Xbox360Controller::Xbox360Controller(libusb_device* dev,
   m_rumble_right(0),
   xbox(m_message_descriptor)
 {
+  m_message_descriptor.set_abs_range(xbox.abs_x1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_x2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_lt, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_rt, 0, 255);
+
   // find endpoints
   endpoint_in  = usb_find_ep(LIBUSB_ENDPOINT_IN,  LIBUSB_CLASS_VENDOR_SPEC, 93, 1);
   endpoint_out = usb_find_ep(LIBUSB_ENDPOINT_OUT, LIBUSB_CLASS_VENDOR_SPEC, 93, 1);
@@ -87,20 +94,21 @@ Xbox360Controller::Xbox360Controller(libusb_device* dev,
 
 Xbox360Controller::~Xbox360Controller()
 {
+  usb_close();
 }
 
 void
 Xbox360Controller::set_rumble_real(uint8_t left, uint8_t right)
 {
   uint8_t rumblecmd[] = { 0x00, 0x08, 0x00, left, right, 0x00, 0x00, 0x00 };
-  usb_write(endpoint_out, rumblecmd, sizeof(rumblecmd));
+  usb_write_coalesced(kOutputRumble, endpoint_out, rumblecmd, sizeof(rumblecmd));
 }
 
 void
 Xbox360Controller::set_led_real(uint8_t status)
 {
   uint8_t ledcmd[] = { 0x01, 0x03, status }; 
-  usb_write(endpoint_out, ledcmd, sizeof(ledcmd));
+  usb_write_coalesced(kOutputLED, endpoint_out, ledcmd, sizeof(ledcmd));
 }
 
 bool
@@ -179,11 +187,14 @@ Xbox360Controller::parse(const uint8_t* data, int len, ControllerMessage* msg_ou
     msg_out->set_abs(xbox.abs_lt, data[4], 0, 255);
     msg_out->set_abs(xbox.abs_rt, data[5], 0, 255);
 
-    msg_out->set_abs(xbox.abs_x1, unpack::int16le(data+6), -32768, 32767);
-    msg_out->set_abs(xbox.abs_x1, unpack::s16_invert(unpack::int16le(data+8)), -32768, 32767);
+    int16_t sticks[4];
+    unpack::int16le_array(data+6, sticks, 4);
+
+    msg_out->set_abs(xbox.abs_x1, sticks[0], -32768, 32767);
+    msg_out->set_abs(xbox.abs_y1, unpack::s16_invert(sticks[1]), -32768, 32767);
 
-    msg_out->set_abs(xbox.abs_x2, unpack::int16le(data+10), -32768, 32767);
-    msg_out->set_abs(xbox.abs_y2, unpack::s16_invert(unpack::int16le(data+12)), -32768, 32767);
+    msg_out->set_abs(xbox.abs_x2, sticks[2], -32768, 32767);
+    msg_out->set_abs(xbox.abs_y2, unpack::s16_invert(sticks[3]), -32768, 32767);
 
     //msg.dummy2 = unpack::int32le(data+14);
     //msg.dummy3 = unpack::int16le(data+18);
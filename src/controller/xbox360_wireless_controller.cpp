@@ -35,6 +35,24 @@ Xbox360WirelessController::Xbox360WirelessController(libusb_device* dev, int con
   m_battery_status(),
   m_serial(),
   xbox(m_message_descriptor)
+{
+  init(controller_id, try_detach);
+}
+
+Xbox360WirelessController::Xbox360WirelessController(const USBDeviceHandlePtr& receiver, int controller_id,
+                                                     bool try_detach) :
+  USBController(receiver),
+  m_endpoint(),
+  m_interface(),
+  m_battery_status(),
+  m_serial(),
+  xbox(m_message_descriptor)
+{
+  init(controller_id, try_detach);
+}
+
+void
+Xbox360WirelessController::init(int controller_id, bool try_detach)
 {
   // FIXME: A little bit of a hack
   m_is_active = false;
@@ -45,12 +63,20 @@ Xbox360WirelessController::Xbox360WirelessController(libusb_device* dev, int con
   m_endpoint  = controller_id*2 + 1;
   m_interface = controller_id*2;
 
+  m_message_descriptor.set_abs_range(xbox.abs_x1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_x2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_lt, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_rt, 0, 255);
+
   usb_claim_interface(m_interface, try_detach);
   usb_submit_read(m_endpoint, 32);
 }
 
 Xbox360WirelessController::~Xbox360WirelessController()
 {
+  usb_close();
 }
 
 void
@@ -59,7 +85,7 @@ Xbox360WirelessController::set_rumble_real(uint8_t left, uint8_t right)
   //                                       +-- typo? might be 0x0c, i.e. length
   //                                       v
   uint8_t rumblecmd[] = { 0x00, 0x01, 0x0f, 0xc0, 0x00, left, right, 0x00, 0x00, 0x00, 0x00, 0x00 };
-  usb_write(m_endpoint, rumblecmd, sizeof(rumblecmd));
+  usb_write_coalesced(kOutputRumble, m_endpoint, rumblecmd, sizeof(rumblecmd));
 }
 
 void
@@ -68,7 +94,7 @@ Xbox360WirelessController::set_led_real(uint8_t status)
   //                                +--- Why not just status?
   //                                v
   uint8_t ledcmd[] = { 0x00, 0x00, 0x08, static_cast<uint8_t>(0x40 + (status % 0x0e)), 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-  usb_write(m_endpoint, ledcmd, sizeof(ledcmd));
+  usb_write_coalesced(kOutputLED, m_endpoint, ledcmd, sizeof(ledcmd));
 }
 
 bool
@@ -157,11 +183,14 @@ Xbox360WirelessController::parse(const uint8_t* data, int len, ControllerMessage
         msg_out->set_abs(xbox.abs_lt, ptr[4], 0, 255);
         msg_out->set_abs(xbox.abs_rt, ptr[5], 0, 255);
 
-        msg_out->set_abs(xbox.abs_x1, unpack::int16le(ptr+6), -32768, 32767);
-        msg_out->set_abs(xbox.abs_y1, unpack::s16_invert(unpack::int16le(ptr+8)), -32768, 32767);
+        int16_t sticks[4];
+        unpack::int16le_array(ptr+6, sticks, 4);
+
+        msg_out->set_abs(xbox.abs_x1, sticks[0], -32768, 32767);
+        msg_out->set_abs(xbox.abs_y1, unpack::s16_invert(sticks[1]), -32768, 32767);
 
-        msg_out->set_abs(xbox.abs_x2, unpack::int16le(ptr+10), -32768, 32767);
-        msg_out->set_abs(xbox.abs_y2, unpack::s16_invert(unpack::int16le(ptr+12)), -32768, 32767);
+        msg_out->set_abs(xbox.abs_x2, sticks[2], -32768, 32767);
+        msg_out->set_abs(xbox.abs_y2, unpack::s16_invert(sticks[3]), -32768, 32767);
 
         return true;
       }
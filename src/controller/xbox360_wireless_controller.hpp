@@ -38,8 +38,15 @@ private:
 
   Xbox360DefaultNames xbox;
 
+private:
+  void init(int controller_id, bool try_detach);
+
 public:
   Xbox360WirelessController(libusb_device* dev, int controller_id, bool try_detach);
+
+  /** Creates the controller for port \a controller_id of a receiver
+      that is shared with the other ports */
+  Xbox360WirelessController(const USBDeviceHandlePtr& receiver, int controller_id, bool try_detach);
   virtual ~Xbox360WirelessController();
 
   bool parse(const uint8_t* data, int len, ControllerMessage* msg_out);
@@ -34,6 +34,19 @@ XboxController::XboxController(libusb_device* dev, bool try_detach) :
   m_endpoint_out(2),
   xbox(m_message_descriptor)
 {
+  m_message_descriptor.set_abs_range(xbox.abs_x1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y1, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_x2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_y2, -32768, 32767);
+  m_message_descriptor.set_abs_range(xbox.abs_lt, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_rt, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_a, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_b, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_x, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_y, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_black, 0, 255);
+  m_message_descriptor.set_abs_range(xbox.abs_white, 0, 255);
+
   // find endpoints
   m_endpoint_in  = usb_find_ep(LIBUSB_ENDPOINT_IN,  88, 66, 0);
   m_endpoint_out = usb_find_ep(LIBUSB_ENDPOINT_OUT, 88, 66, 0);
@@ -44,13 +57,14 @@ XboxController::XboxController(libusb_device* dev, bool try_detach) :
 
 XboxController::~XboxController()
 {
+  usb_close();
 }
 
 void
 XboxController::set_rumble_real(uint8_t left, uint8_t right)
 {
   uint8_t rumblecmd[] = { 0x00, 0x06, 0x00, left, 0x00, right };
-  usb_write(m_endpoint_out, rumblecmd, sizeof(rumblecmd));
+  usb_write_coalesced(kOutputRumble, m_endpoint_out, rumblecmd, sizeof(rumblecmd));
 }
 
 void
@@ -93,11 +107,14 @@ XboxController::parse(const uint8_t* data, int len, ControllerMessage* msg_out)
     msg_out->set_abs(xbox.abs_rt, data[11], 0, 255);
 
 
-    msg_out->set_abs(xbox.abs_x1, unpack::int16le(data+12), -32768, 32767);
-    msg_out->set_abs(xbox.abs_y1, unpack::int16le(data+13), -32768, 32767);
+    int16_t sticks[4];
+    unpack::int16le_array(data+12, sticks, 4);
+
+    msg_out->set_abs(xbox.abs_x1, sticks[0], -32768, 32767);
+    msg_out->set_abs(xbox.abs_y1, sticks[1], -32768, 32767);
 
-    msg_out->set_abs(xbox.abs_x2, unpack::int16le(data+14), -32768, 32767);
-    msg_out->set_abs(xbox.abs_y2, unpack::int16le(data+15), -32768, 32767);
+    msg_out->set_abs(xbox.abs_x2, sticks[2], -32768, 32767);
+    msg_out->set_abs(xbox.abs_y2, sticks[3], -32768, 32767);
 
     return true;
   }
@@ -29,6 +29,7 @@
 
 ControllerConfig::ControllerConfig(UInput& uinput, int slot, bool extra_devices, const ControllerOptions& opts) :
   m_modifier(),
+  m_modifier_program(),
   m_emitter(uinput, slot, extra_devices, opts.uinput)
 {
   // create modifier
@@ -164,6 +165,17 @@ ControllerConfig::ControllerConfig(UInput& uinput, int slot, bool extra_devices,
   }
 }
 
+void
+ControllerConfig::init_modifier(ControllerMessageDescriptor& desc)
+{
+  for(std::vector<ModifierPtr>::iterator i = m_modifier.begin(); i != m_modifier.end(); ++i)
+  {
+    (*i)->init(desc);
+  }
+
+  m_modifier_program.compile(m_modifier);
+}
+
 std::vector<ModifierPtr>&
 ControllerConfig::get_modifier()
 {
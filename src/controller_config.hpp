@@ -21,6 +21,7 @@
 
 #include "event_emitter.hpp"
 #include "modifier.hpp"
+#include "modifier_program.hpp"
 
 class ControllerOptions;
 class ControllerConfig;
@@ -30,13 +31,19 @@ class ControllerConfig
 {
 private:
   std::vector<ModifierPtr> m_modifier;
+  ModifierProgram m_modifier_program;
   EventEmitter m_emitter;
 
 public:
   ControllerConfig(UInput& uinput, int slot, bool extra_devices, 
                    const ControllerOptions& opts);
 
+  /** Initializes the modifiers against \a desc and compiles them
+      into the ModifierProgram */
+  void init_modifier(ControllerMessageDescriptor& desc);
+
   std::vector<ModifierPtr>& get_modifier();
+  const ModifierProgram& get_modifier_program() const { return m_modifier_program; }
   EventEmitter& get_emitter();
 
 private:
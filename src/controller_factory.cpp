@@ -18,6 +18,7 @@
 
 #include "controller_factory.hpp"
 
+#include <boost/lexical_cast.hpp>
 #include <stdexcept>
 
 #include "controller/firestorm_dual_controller.hpp"
@@ -25,6 +26,7 @@
 #include "controller/hama_crux_controller.hpp"
 #include "controller/logitech_f310_controller.hpp"
 #include "controller/playstation3_usb_controller.hpp"
+#include "controller/replay_controller.hpp"
 #include "controller/saitek_p2500_controller.hpp"
 #include "controller/wiimote_controller.hpp"
 #include "controller/xbox360_controller.hpp"
@@ -92,6 +94,7 @@ ControllerFactory::create(const XPadDevice& dev_type, libusb_device* dev, const
       {
         Options::GenericUSBSpec spec = opts.find_generic_usb_spec(dev_type.idVendor, dev_type.idProduct);
         return ControllerPtr(new GenericUSBController(dev, spec.m_interface, spec.m_endpoint, 
+                                                      opts.generic_usb_layout,
                                                       opts.detach_kernel_driver));
       }
 
@@ -132,9 +135,14 @@ ControllerFactory::create_multiple(const XPadDevice& dev_type, libusb_device* de
       break;
 
     case GAMEPAD_XBOX360_WIRELESS:
-      for(int wireless_id = 0; wireless_id < 4; ++wireless_id)
       {
-        lst.push_back(ControllerPtr(new Xbox360WirelessController(dev, wireless_id, opts.detach_kernel_driver)));
+        // open the receiver only once and share it between all four ports
+        USBDeviceHandlePtr receiver(new USBDeviceHandle(dev));
+        for(int wireless_id = 0; wireless_id < 4; ++wireless_id)
+        {
+          lst.push_back(ControllerPtr(new Xbox360WirelessController(receiver, wireless_id, 
+                                                                    opts.detach_kernel_driver)));
+        }
       }
       break;
 
@@ -175,6 +183,7 @@ ControllerFactory::create_multiple(const XPadDevice& dev_type, libusb_device* de
       {
         Options::GenericUSBSpec spec = opts.find_generic_usb_spec(dev_type.idVendor, dev_type.idProduct);
         lst.push_back(ControllerPtr(new GenericUSBController(dev, spec.m_interface, spec.m_endpoint, 
+                                                             opts.generic_usb_layout,
                                                              opts.detach_kernel_driver)));
       }
       break;
@@ -186,4 +195,48 @@ ControllerFactory::create_multiple(const XPadDevice& dev_type, libusb_device* de
   return lst;
 }
 
+ControllerPtr
+ControllerFactory::create_replay(const XPadDevice& dev_type, const std::string& filename, const Options& opts)
+{
+  switch (dev_type.type)
+  {
+    case GAMEPAD_XBOX360_PLAY_N_CHARGE:
+    case GAMEPAD_WIIMOTE:
+    case GAMEPAD_GENERIC_USB:
+    case GAMEPAD_UNKNOWN:
+      throw std::runtime_error("replaying USB traces is not supported for this controller type");
+
+    default:
+      {
+        // the chatpad and headset talk to the device directly, so
+        // they aren't available offline
+        Options offline_opts = opts;
+        offline_opts.chatpad = false;
+        offline_opts.headset = false;
+
+        boost::shared_ptr<USBController> parser 
+          = boost::dynamic_pointer_cast<USBController>(create(dev_type, NULL, offline_opts));
+        assert(parser);
+
+        int busnum = -1;
+        int devnum = -1;
+        if (!opts.busid.empty() && !opts.devid.empty())
+        {
+          busnum = boost::lexical_cast<int>(opts.busid);
+          devnum = boost::lexical_cast<int>(opts.devid);
+        }
+
+        // the ports of a wireless receiver share one trace
+        int endpoint = -1;
+        if (dev_type.type == GAMEPAD_XBOX360_WIRELESS)
+        {
+          endpoint = opts.wireless_id * 2 + 1;
+        }
+
+        return ControllerPtr(new ReplayController(filename, parser, busnum, devnum, endpoint,
+                                                  !opts.replay_fast));
+      }
+  }
+}
+
 /* EOF */
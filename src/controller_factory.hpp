@@ -34,6 +34,12 @@ public:
   static std::vector<ControllerPtr> create_multiple(const XPadDevice& dev_type, 
                                                     libusb_device* dev, const Options& opts);
 
+  /** Creates a controller that replays the USB trace \a filename
+      through the parser of the controller given by \a dev_type */
+  static ControllerPtr create_replay(const XPadDevice& dev_type, 
+                                     const std::string& filename,
+                                     const Options& opts);
+
 private:
   ControllerFactory(const ControllerFactory&);
   ControllerFactory& operator=(const ControllerFactory&);
@@ -26,26 +26,97 @@
 
 #include "helper.hpp"
 #include "controller_message_descriptor.hpp"
+#include "int_diff.hpp"
 
 ControllerMessage::ControllerMessage() :
-  // FIXME: should get proper size from ControllerMessageDescriptor
-  // instead of hardcoded defaults
-  m_abs_state(),
-  m_abs_min(),
-  m_abs_max(),
-  m_rel_state(),
-  m_key_state()
+  m_time(0),
+  m_abs_count(0),
+  m_rel_count(0),
+  m_key_state(),
+  m_key_changed(),
+  m_abs_changed(),
+  m_rel_changed()
 {
+  // the value arrays are left uninitialized, nothing reads above the
+  // high-water marks
+}
+
+ControllerMessage::ControllerMessage(const ControllerMessage& rhs) :
+  m_time(),
+  m_abs_count(),
+  m_rel_count(),
+  m_key_state(),
+  m_key_changed()
+{
+  copy_from(rhs);
+}
+
+ControllerMessage&
+ControllerMessage::operator=(const ControllerMessage& rhs)
+{
+  if (this != &rhs)
+  {
+    copy_from(rhs);
+  }
+  return *this;
+}
+
+void
+ControllerMessage::copy_from(const ControllerMessage& rhs)
+{
+  m_time = rhs.m_time;
+  m_abs_count = rhs.m_abs_count;
+  m_rel_count = rhs.m_rel_count;
+  m_key_state = rhs.m_key_state;
+
+  m_key_changed = rhs.m_key_changed;
+  std::copy(rhs.m_abs_changed, rhs.m_abs_changed + kAbsWords, m_abs_changed);
+  std::copy(rhs.m_rel_changed, rhs.m_rel_changed + kRelWords, m_rel_changed);
+
+  std::copy(rhs.m_abs_value, rhs.m_abs_value + m_abs_count, m_abs_value);
+  std::copy(rhs.m_abs_min,   rhs.m_abs_min   + m_abs_count, m_abs_min);
+  std::copy(rhs.m_abs_max,   rhs.m_abs_max   + m_abs_count, m_abs_max);
+  std::copy(rhs.m_rel, rhs.m_rel + m_rel_count, m_rel);
 }
 
 void
 ControllerMessage::clear()
 {
-  std::fill(m_abs_state.begin(), m_abs_state.end(), 0);
-  std::fill(m_abs_min.begin(), m_abs_min.end(), 0);
-  std::fill(m_abs_max.begin(), m_abs_max.end(), 0);
-  std::fill(m_rel_state.begin(), m_rel_state.end(), 0);
+  m_time = 0;
+  m_abs_count = 0;
+  m_rel_count = 0;
   m_key_state.reset();
+  m_key_changed.reset();
+  std::fill(m_abs_changed, m_abs_changed + kAbsWords, 0);
+  std::fill(m_rel_changed, m_rel_changed + kRelWords, 0);
+}
+
+void
+ControllerMessage::grow_abs(int abs)
+{
+  assert(0 <= abs && abs < kMaxAbs);
+
+  if (abs >= m_abs_count)
+  {
+    // slots between the old high-water mark and abs read as zero
+    // already, so make the storage agree before exposing it
+    std::fill(m_abs_value + m_abs_count, m_abs_value + abs + 1, 0);
+    std::fill(m_abs_min   + m_abs_count, m_abs_min   + abs + 1, 0);
+    std::fill(m_abs_max   + m_abs_count, m_abs_max   + abs + 1, 0);
+    m_abs_count = abs + 1;
+  }
+}
+
+void
+ControllerMessage::grow_rel(int rel)
+{
+  assert(0 <= rel && rel < kMaxRel);
+
+  if (rel >= m_rel_count)
+  {
+    std::fill(m_rel + m_rel_count, m_rel + rel + 1, 0);
+    m_rel_count = rel + 1;
+  }
 }
 
 bool
@@ -63,13 +134,21 @@ ControllerMessage::set_key(int key, bool v)
 int
 ControllerMessage::get_abs(int abs) const
 {
-  return m_abs_state[abs];
+  if (abs < m_abs_count)
+  {
+    return m_abs_value[abs];
+  }
+  else
+  {
+    return 0;
+  }
 }
 
 void
 ControllerMessage::set_abs(int abs, int v, int min, int max)
 {
-  m_abs_state[abs] = v;
+  grow_abs(abs);
+  m_abs_value[abs] = v;
   m_abs_min[abs] = min;
   m_abs_max[abs] = max;
 }
@@ -77,48 +156,148 @@ ControllerMessage::set_abs(int abs, int v, int min, int max)
 float
 ControllerMessage::get_abs_float(int abs) const
 {
-  return to_float(m_abs_state[abs], m_abs_min[abs], m_abs_max[abs]);
+  return to_float(get_abs(abs), get_abs_min(abs), get_abs_max(abs));
 }
 
 void
 ControllerMessage::set_abs_float(int abs, float v)
 {
-  m_abs_state[abs] = from_float(v, -32768, 32767);
-  m_abs_min[abs] = -32768;
-  m_abs_max[abs] = 32767;
+  // modifiers like rotate can overshoot the unit range, clamp so
+  // that the value stays within the range it is stored with
+  set_abs(abs, from_float(Math::clamp(-1.0f, v, 1.0f), -32768, 32767), -32768, 32767);
 }
 
 int
 ControllerMessage::get_rel(int rel) const
 {
-  return m_rel_state[rel];
+  if (rel < m_rel_count)
+  {
+    return m_rel[rel];
+  }
+  else
+  {
+    return 0;
+  }
 }
 
 void
 ControllerMessage::set_rel(int rel, int v)
 {
-  m_rel_state[rel] = v;
+  grow_rel(rel);
+  m_rel[rel] = v;
 }
-
+
 int
-ControllerMessage::get_abs_min(int abs)
+ControllerMessage::get_abs_min(int abs) const
 {
-  return m_abs_min[abs];
+  if (abs < m_abs_count)
+  {
+    return m_abs_min[abs];
+  }
+  else
+  {
+    return 0;
+  }
 }
 
 int
-ControllerMessage::get_abs_max(int abs)
+ControllerMessage::get_abs_max(int abs) const
+{
+  if (abs < m_abs_count)
+  {
+    return m_abs_max[abs];
+  }
+  else
+  {
+    return 0;
+  }
+}
+
+namespace {
+
+/** Flag the slots in [begin, end) of \a values that are non-zero,
+    used for the part of the longer message the other one lacks */
+bool diff_tail(const int* values, int begin, int end, uint32_t* mask)
+{
+  bool any = false;
+  for(int i = begin; i < end; ++i)
+  {
+    if (values[i] != 0)
+    {
+      mask[i / 32] |= 1u << (i % 32);
+      any = true;
+    }
+  }
+  return any;
+}
+
+} // namespace
+
+bool
+ControllerMessage::update_changes(const ControllerMessage& prev)
+{
+  m_key_changed = m_key_state ^ prev.m_key_state;
+  bool changed = m_key_changed.any();
+
+  std::fill(m_abs_changed, m_abs_changed + kAbsWords, 0);
+  const int abs_common = std::min(m_abs_count, prev.m_abs_count);
+  changed |= int_diff(m_abs_value, prev.m_abs_value, abs_common, m_abs_changed);
+  changed |= int_diff(m_abs_min,   prev.m_abs_min,   abs_common, m_abs_changed);
+  changed |= int_diff(m_abs_max,   prev.m_abs_max,   abs_common, m_abs_changed);
+  {
+    const ControllerMessage& longer = (m_abs_count > prev.m_abs_count) ? *this : prev;
+    changed |= diff_tail(longer.m_abs_value, abs_common, longer.m_abs_count, m_abs_changed);
+    changed |= diff_tail(longer.m_abs_min,   abs_common, longer.m_abs_count, m_abs_changed);
+    changed |= diff_tail(longer.m_abs_max,   abs_common, longer.m_abs_count, m_abs_changed);
+  }
+
+  std::fill(m_rel_changed, m_rel_changed + kRelWords, 0);
+  const int rel_common = std::min(m_rel_count, prev.m_rel_count);
+  changed |= int_diff(m_rel, prev.m_rel, rel_common, m_rel_changed);
+  {
+    const ControllerMessage& longer = (m_rel_count > prev.m_rel_count) ? *this : prev;
+    changed |= diff_tail(longer.m_rel, rel_common, longer.m_rel_count, m_rel_changed);
+  }
+
+  return changed;
+}
+
+void
+ControllerMessage::mark_all_changed()
 {
-  return m_abs_max[abs];
+  m_key_changed.set();
+  std::fill(m_abs_changed, m_abs_changed + kAbsWords, ~0u);
+  std::fill(m_rel_changed, m_rel_changed + kRelWords, ~0u);
 }
 
 bool
 ControllerMessage::operator==(const ControllerMessage& rhs) const
 {
-  return 
-    m_abs_state == rhs.m_abs_state &&
-    m_rel_state == rhs.m_rel_state &&
-    m_key_state == rhs.m_key_state;
+  if (m_key_state != rhs.m_key_state)
+  {
+    return false;
+  }
+
+  // slots above either high-water mark compare as zero
+  uint32_t abs_mask[kAbsWords] = {};
+  const int abs_common = std::min(m_abs_count, rhs.m_abs_count);
+  const ControllerMessage& abs_longer = (m_abs_count > rhs.m_abs_count) ? *this : rhs;
+  if (int_diff(m_abs_value, rhs.m_abs_value, abs_common, abs_mask) ||
+      diff_tail(abs_longer.m_abs_value, abs_common, abs_longer.m_abs_count, abs_mask))
+  {
+    return false;
+  }
+
+  uint32_t rel_mask[kRelWords] = {};
+  const int rel_common = std::min(m_rel_count, rhs.m_rel_count);
+  const ControllerMessage& rel_longer = (m_rel_count > rhs.m_rel_count) ? *this : rhs;
+  if (int_diff(m_rel, rhs.m_rel, rel_common, rel_mask) ||
+      diff_tail(rel_longer.m_rel, rel_common, rel_longer.m_rel_count, rel_mask))
+  {
+    return false;
+  }
+
+  return true;
 }
 
 bool
@@ -126,7 +305,7 @@ ControllerMessage::operator!=(const ControllerMessage& rhs) const
 {
   return !((*this) == rhs);
 }
-
+
 std::ostream& format_generic(std::ostream& out, const ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   for(int i = 0; i < desc.get_key_count(); ++i)
@@ -19,36 +19,67 @@
 #ifndef HEADER_XBOXDRV_CONTROLLER_MESSAGE_HPP
 #define HEADER_XBOXDRV_CONTROLLER_MESSAGE_HPP
 
-#include <boost/array.hpp>
 #include <bitset>
+#include <stdint.h>
 #include <linux/input.h>
 
 #include "xboxmsg.hpp"
 
 class ControllerMessageDescriptor;
 
+/** ControllerMessage has room for kMaxAbs abs and kMaxRel rel slots,
+    but only touches the slots that are actually in use: a high-water
+    mark tracks how many leading slots have been written, everything
+    above it reads as zero and is skipped on copy, compare and clear.
+    The object itself stays at its full size, about 4 KiB, copying
+    one costs a few dozen bytes of slot data for a typical gamepad
+    instead of the whole table. */
 class ControllerMessage
 {
+public:
+  enum { kMaxAbs = 256, kMaxRel = 256 };
+
 private:
-  boost::array<int, 256> m_abs_state;
-  boost::array<int, 256> m_abs_min;
-  boost::array<int, 256> m_abs_max;
-  boost::array<int, 256> m_rel_state;
-  std::bitset<256>       m_key_state;
+  enum { kAbsWords = kMaxAbs / 32, kRelWords = kMaxRel / 32 };
+
+  /** monotonic time in usec at which the data arrived, 0 if unknown */
+  int64_t m_time;
+
+  int m_abs_count;
+  int m_rel_count;
+  std::bitset<256> m_key_state;
+
+  /** slots that differ from the previously emitted message, filled
+      in by update_changes(), one bit per slot */
+  std::bitset<256> m_key_changed;
+  uint32_t m_abs_changed[kAbsWords];
+  uint32_t m_rel_changed[kRelWords];
+
+  // kept as separate arrays so that int_diff() can compare them
+  int m_abs_value[kMaxAbs];
+  int m_abs_min[kMaxAbs];
+  int m_abs_max[kMaxAbs];
+  int m_rel[kMaxRel];
 
 public:
   ControllerMessage();
+  ControllerMessage(const ControllerMessage& rhs);
+  ControllerMessage& operator=(const ControllerMessage& rhs);
  
   void clear();
 
+  int64_t get_time() const { return m_time; }
+  void set_time(int64_t usec) { m_time = usec; }
+
   bool get_key(int key) const;
   void set_key(int key, bool v);
 
   void set_key_state(const std::bitset<256>& state) { m_key_state = state; }
   const std::bitset<256>& get_key_state() const { return m_key_state; }
-  const boost::array<int, 256>& get_abs_state() const { return m_abs_state; }
-  const boost::array<int, 256>& get_abs_min() const { return m_abs_min; }
-  const boost::array<int, 256>& get_abs_max() const { return m_abs_max; }
+
+  /** number of leading abs/rel slots that hold data */
+  int get_abs_count() const { return m_abs_count; }
+  int get_rel_count() const { return m_rel_count; }
 
   int  get_abs(int abs) const;
   void set_abs(int abs, int v, int min, int max);
@@ -59,11 +90,30 @@ public:
   float get_abs_float(int abs) const;
   void  set_abs_float(int abs, float v);
 
-  int get_abs_min(int abs);
-  int get_abs_max(int abs);
+  int get_abs_min(int abs) const;
+  int get_abs_max(int abs) const;
+
+  /** Compare against \a prev and record which key, abs and rel slots
+      differ from it, returns true if anything changed. An abs slot
+      counts as changed when either its value or its range moved. */
+  bool update_changes(const ControllerMessage& prev);
+
+  /** Flag every slot as changed, used when the receiver of the
+      message has no previous state to compare against */
+  void mark_all_changed();
+
+  bool key_changed(int key) const { return m_key_changed[key]; }
+  bool keys_changed() const { return m_key_changed.any(); }
+  bool abs_changed(int abs) const { return (m_abs_changed[abs / 32] >> (abs % 32)) & 1u; }
+  bool rel_changed(int rel) const { return (m_rel_changed[rel / 32] >> (rel % 32)) & 1u; }
 
   bool operator==(const ControllerMessage& rhs) const;
   bool operator!=(const ControllerMessage& rhs) const;
+
+private:
+  void copy_from(const ControllerMessage& rhs);
+  void grow_abs(int abs);
+  void grow_rel(int rel);
 };
 
 std::ostream& operator<<(std::ostream& out, const ControllerMessage& msg);
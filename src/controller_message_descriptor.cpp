@@ -25,8 +25,31 @@
 ControllerMessageDescriptor::ControllerMessageDescriptor() :
   m_abs(),
   m_key(),
-  m_rel()
+  m_rel(),
+  m_abs_ranges()
 {
 }
 
+void
+ControllerMessageDescriptor::set_abs_range(int abs, int min, int max)
+{
+  m_abs_ranges[abs] = std::make_pair(min, max);
+}
+
+bool
+ControllerMessageDescriptor::get_abs_range(int abs, int& min, int& max) const
+{
+  std::map<int, std::pair<int, int> >::const_iterator it = m_abs_ranges.find(abs);
+  if (it == m_abs_ranges.end())
+  {
+    return false;
+  }
+  else
+  {
+    min = it->second.first;
+    max = it->second.second;
+    return true;
+  }
+}
+
 /* EOF */
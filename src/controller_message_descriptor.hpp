@@ -32,6 +32,10 @@ private:
   SymbolTable<KeyName> m_key;
   SymbolTable<RelName> m_rel;
 
+  /** the range abs slots are reported with, where the controller
+      knows it up front */
+  std::map<int, std::pair<int, int> > m_abs_ranges;
+
 public:
   ControllerMessageDescriptor();
 
@@ -46,6 +50,14 @@ public:
   int get_key_count() const { return m_key.size(); }
   int get_abs_count() const { return m_abs.size(); }
   int get_rel_count() const { return m_rel.size(); }
+
+  /** Declares the range \a abs is reported with, a hint that lets
+      consumers prepare for it in init(), messages may still carry
+      other ranges */
+  void set_abs_range(int abs, int min, int max);
+
+  /** Returns false if the range of \a abs isn't known up front */
+  bool get_abs_range(int abs, int& min, int& max) const;
 };
 
 #endif
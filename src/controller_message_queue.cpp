@@ -0,0 +1,133 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2012 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "controller_message_queue.hpp"
+
+#include "log.hpp"
+
+ControllerMessageQueue::ControllerMessageQueue(int capacity,
+                                               const boost::function<void (const ControllerMessage&)>& callback) :
+  // one slot is kept free to tell full from empty, one is held by
+  // the consumer
+  m_buffer(capacity + 2),
+  m_head(0),
+  m_read(0),
+  m_tail(0),
+  m_dropped(0),
+  m_callback(callback),
+  m_source_funcs(),
+  m_source()
+{
+  m_source_funcs.prepare  = &ControllerMessageQueue::on_source_prepare;
+  m_source_funcs.check    = &ControllerMessageQueue::on_source_check;
+  m_source_funcs.dispatch = &ControllerMessageQueue::on_source_dispatch;
+  m_source_funcs.finalize = NULL;
+
+  m_source_funcs.closure_callback = NULL;
+  m_source_funcs.closure_marshal  = NULL;
+
+  m_source = reinterpret_cast<GControllerMessageSource*>(g_source_new(&m_source_funcs, sizeof(GControllerMessageSource)));
+  m_source->queue = this;
+  g_source_attach(&m_source->source, NULL);
+}
+
+ControllerMessageQueue::~ControllerMessageQueue()
+{
+  g_source_destroy(&m_source->source);
+  g_source_unref(&m_source->source);
+}
+
+ControllerMessage*
+ControllerMessageQueue::begin_push()
+{
+  const int size = static_cast<int>(m_buffer.size());
+  const int tail = g_atomic_int_get(&m_tail);
+  const int next = (tail + 1) % size;
+
+  if (next == g_atomic_int_get(&m_head))
+  {
+    // the main loop is not keeping up, drop the message instead of
+    // blocking the USB thread
+    if (g_atomic_int_add(&m_dropped, 1) == 0)
+    {
+      log_warn("message queue full, dropping messages");
+    }
+    return 0;
+  }
+  else
+  {
+    m_buffer[tail].clear();
+    return &m_buffer[tail];
+  }
+}
+
+void
+ControllerMessageQueue::commit_push()
+{
+  const int size = static_cast<int>(m_buffer.size());
+  const int tail = g_atomic_int_get(&m_tail);
+
+  // publish the slot only after the message has been written
+  g_atomic_int_set(&m_tail, (tail + 1) % size);
+
+  g_main_context_wakeup(NULL);
+}
+
+bool
+ControllerMessageQueue::empty() const
+{
+  return m_read == g_atomic_int_get(&m_tail);
+}
+
+void
+ControllerMessageQueue::dispatch()
+{
+  const int size = static_cast<int>(m_buffer.size());
+  const int tail = g_atomic_int_get(&m_tail);
+
+  while (m_read != tail)
+  {
+    m_callback(m_buffer[m_read]);
+    // give the slots before the one just delivered back to the
+    // producer, the delivered one stays with the consumer
+    g_atomic_int_set(&m_head, m_read);
+    m_read = (m_read + 1) % size;
+  }
+}
+
+gboolean
+ControllerMessageQueue::on_source_prepare(GSource* source, gint* timeout)
+{
+  *timeout = -1;
+  return !reinterpret_cast<GControllerMessageSource*>(source)->queue->empty();
+}
+
+gboolean
+ControllerMessageQueue::on_source_check(GSource* source)
+{
+  return !reinterpret_cast<GControllerMessageSource*>(source)->queue->empty();
+}
+
+gboolean
+ControllerMessageQueue::on_source_dispatch(GSource* source, GSourceFunc callback, gpointer userdata)
+{
+  reinterpret_cast<GControllerMessageSource*>(source)->queue->dispatch();
+  return TRUE;
+}
+
+/* EOF */
@@ -0,0 +1,89 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2012 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_XBOXDRV_CONTROLLER_MESSAGE_QUEUE_HPP
+#define HEADER_XBOXDRV_CONTROLLER_MESSAGE_QUEUE_HPP
+
+#include <boost/function.hpp>
+#include <glib.h>
+#include <vector>
+
+#include "controller_message.hpp"
+
+class ControllerMessageQueue;
+
+struct GControllerMessageSource
+{
+  GSource source;
+  ControllerMessageQueue* queue;
+};
+
+/** Hands ControllerMessages from the USB event thread over to the
+    glib main loop. begin_push()/commit_push() are called from the
+    producer thread and never block, the messages are delivered to
+    the callback from the main loop. The queue is a
+    single-producer/single-consumer ring buffer, so no lock is
+    involved on either side.
+
+    The producer parses directly into the ring slot and the callback
+    receives a reference to it. The last delivered message stays
+    reserved until the next one is delivered, so the consumer can
+    hold on to it without taking a copy. */
+class ControllerMessageQueue
+{
+private:
+  std::vector<ControllerMessage> m_buffer;
+  volatile gint m_head; /// oldest slot still owned by the main loop, only written by it
+  int m_read; /// next slot to deliver, only used by the main loop
+  volatile gint m_tail; /// next slot to write, only written by the producer
+  volatile gint m_dropped;
+
+  boost::function<void (const ControllerMessage&)> m_callback;
+
+  GSourceFuncs m_source_funcs;
+  GControllerMessageSource* m_source;
+
+public:
+  ControllerMessageQueue(int capacity, const boost::function<void (const ControllerMessage&)>& callback);
+  ~ControllerMessageQueue();
+
+  /** Returns the cleared slot for the next message or NULL if the
+      queue is full, in which case the message is to be dropped */
+  ControllerMessage* begin_push();
+
+  /** Publishes the slot returned by begin_push() and wakes up the
+      main loop, not calling it discards the slot */
+  void commit_push();
+
+  bool empty() const;
+
+private:
+  void dispatch();
+
+  static gboolean on_source_prepare(GSource* source, gint* timeout);
+  static gboolean on_source_check(GSource* source);
+  static gboolean on_source_dispatch(GSource* source, GSourceFunc callback, gpointer userdata);
+
+private:
+  ControllerMessageQueue(const ControllerMessageQueue&);
+  ControllerMessageQueue& operator=(const ControllerMessageQueue&);
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,74 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_CONTROLLER_MESSAGE_SLOT_HPP
+#define HEADER_XBOXDRV_CONTROLLER_MESSAGE_SLOT_HPP
+
+#include "controller_message.hpp"
+
+/** Double buffered ControllerMessage that a parser fills in place.
+    begin() hands out the back buffer, commit() turns it into the
+    front buffer, which stays untouched until the next commit(). This
+    lets the receiver of a submitted message keep a reference to it
+    instead of copying it. */
+class ControllerMessageSlot
+{
+private:
+  ControllerMessage m_buffers[2];
+  int m_back;
+
+public:
+  ControllerMessageSlot() :
+    m_buffers(),
+    m_back(0)
+  {}
+
+  /** Returns the cleared back buffer for the parser to write into */
+  ControllerMessage& begin()
+  {
+    m_buffers[m_back].clear();
+    return m_buffers[m_back];
+  }
+
+  /** Makes the back buffer the new front buffer and returns it, the
+      buffer is owned by the receiver until the next commit() */
+  const ControllerMessage& commit()
+  {
+    const ControllerMessage& msg = m_buffers[m_back];
+    m_back ^= 1;
+    return msg;
+  }
+
+  /** Copies \a msg into the back buffer and commits it, for
+      controllers that keep their state in a message of their own and
+      update it across several events */
+  const ControllerMessage& commit(const ControllerMessage& msg)
+  {
+    m_buffers[m_back] = msg;
+    return commit();
+  }
+
+private:
+  ControllerMessageSlot(const ControllerMessageSlot&);
+  ControllerMessageSlot& operator=(const ControllerMessageSlot&);
+};
+
+#endif
+
+/* EOF */
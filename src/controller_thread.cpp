@@ -18,7 +18,9 @@
 
 #include "controller_thread.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <boost/bind.hpp>
 #include <glib.h>
 
@@ -35,38 +37,95 @@ ControllerThread::ControllerThread(ControllerPtr controller,
                                    const Options& opts) :
   m_controller(controller),
   m_processor(new MessageProcessor(config, m_controller->get_message_descriptor(), opts)),
-  m_oldrealmsg(),
+  m_idlemsg(),
+  m_oldrealmsg(&m_idlemsg),
   m_timeout(opts.timeout),
   m_print_messages(!opts.silent),
   m_timeout_id(),
-  m_timer(g_timer_new())
+  m_timeout_due(),
+  m_last_time(g_get_monotonic_time())
 {
-  m_timeout_id = g_timeout_add(m_timeout, &ControllerThread::on_timeout_wrap, this);
   m_controller->set_message_cb(boost::bind(&ControllerThread::on_message, this, _1));
   if (m_processor.get())
   {
     m_processor->set_ff_callback(boost::bind(&Controller::set_rumble, m_controller.get(), _1, _2));
   }
+  update_timeout();
 }
 
 ControllerThread::~ControllerThread()
 {
-  g_source_remove(m_timeout_id);
-  g_timer_destroy(m_timer);
+  if (m_timeout_id)
+  {
+    g_source_remove(m_timeout_id);
+  }
+}
+
+void
+ControllerThread::update_timeout()
+{
+  int next = m_processor.get() ? m_processor->get_next_update() : -1;
+
+  if (next < 0)
+  {
+    // nothing time dependent is going on, so sleep until the next
+    // message comes in
+    if (m_timeout_id)
+    {
+      g_source_remove(m_timeout_id);
+      m_timeout_id = 0;
+    }
+  }
+  else
+  {
+    // don't update more often than --timeout asks for
+    next = std::max(next, m_timeout);
+
+    const gint64 due = g_get_monotonic_time() + static_cast<gint64>(next) * 1000;
+    if (!m_timeout_id || due < m_timeout_due)
+    {
+      if (m_timeout_id)
+      {
+        g_source_remove(m_timeout_id);
+      }
+      m_timeout_id  = g_timeout_add(next, &ControllerThread::on_timeout_wrap, this);
+      m_timeout_due = due;
+    }
+  }
 }
 
 bool
 ControllerThread::on_timeout()
 {
+  m_timeout_id = 0;
+
   if (m_processor.get())
   {
-    int msec_delta = static_cast<int>(g_timer_elapsed(m_timer, NULL) * 1000.0f);
-    g_timer_reset(m_timer);
+    int usec_delta = advance_time(g_get_monotonic_time());
 
-    m_processor->send(m_oldrealmsg, m_controller->get_message_descriptor(), msec_delta);
+    m_processor->send(*m_oldrealmsg, m_controller->get_message_descriptor(), usec_delta);
   }
 
-  return true; // do not remove the callback
+  update_timeout();
+
+  return false; // update_timeout() registered a new one if needed
+}
+
+int
+ControllerThread::advance_time(gint64 now)
+{
+  if (now <= m_last_time)
+  {
+    // a message stamped before the last tick, which can happen with
+    // --usb-thread, that time has already been accounted for
+    return 0;
+  }
+  else
+  {
+    const gint64 delta = now - m_last_time;
+    m_last_time = now;
+    return static_cast<int>(std::min(delta, static_cast<gint64>(std::numeric_limits<int>::max())));
+  }
 }
 
 void
@@ -78,15 +137,20 @@ ControllerThread::on_message(const ControllerMessage& msg)
     format_generic(std::cout, msg, m_controller->get_message_descriptor()) << std::endl;
   }
 
-  m_oldrealmsg = msg;
+  // the controller keeps msg alive until the next one is submitted,
+  // so there is no need to copy it
+  m_oldrealmsg = &msg;
+
+  // controllers that don't stamp their messages deliver them right
+  // away, so the time of arrival is good enough for them
+  int usec_delta = advance_time(msg.get_time() ? msg.get_time() : g_get_monotonic_time());
 
-  int msec_delta = static_cast<int>(g_timer_elapsed(m_timer, NULL) * 1000.0f);
-  g_timer_reset(m_timer);
-    
   if (m_processor.get())
   {
-    m_processor->send(msg, m_controller->get_message_descriptor(), msec_delta);
+    m_processor->send(msg, m_controller->get_message_descriptor(), usec_delta);
   }
+
+  update_timeout();
 }
 
 /* EOF */
@@ -43,12 +43,14 @@ private:
   ControllerPtr m_controller;
   std::auto_ptr<MessageProcessor> m_processor;
 
-  ControllerMessage m_oldrealmsg; /// last data read from the device
+  ControllerMessage m_idlemsg; /// used until the device sends something
+  const ControllerMessage* m_oldrealmsg; /// last data read from the device, owned by the controller
 
   int  m_timeout;
   bool m_print_messages;
-  guint m_timeout_id;
-  GTimer* m_timer;
+  guint m_timeout_id; /// 0 while no update is due
+  gint64 m_timeout_due; /// monotonic time in usec at which m_timeout_id fires
+  gint64 m_last_time; /// monotonic time in usec of the last update
 
 public:
   ControllerThread(ControllerPtr controller, ControllerSlotConfigPtr config, const Options& opts);
@@ -57,9 +59,18 @@ public:
   MessageProcessor* get_message_proc() const { return m_processor.get(); }
   ControllerPtr get_controller() const { return m_controller; }
 
+  /** Arms the timeout for the next update the MessageProcessor asks
+      for, or removes it when it is idle. Has to be called after
+      changing the MessageProcessor from outside. */
+  void update_timeout();
+
 private:
   void on_message(const ControllerMessage& msg);
 
+  /** Returns the usec passed between the last update and \a now and
+      moves the time of the last update forward */
+  int advance_time(gint64 now);
+
   bool on_timeout();
   static gboolean on_timeout_wrap(gpointer data) {
     return static_cast<ControllerThread*>(data)->on_timeout();
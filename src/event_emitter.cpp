@@ -42,21 +42,28 @@ EventEmitter::init(const ControllerMessageDescriptor& desc)
 void
 EventEmitter::send(const ControllerMessage& msg)
 {
-  m_btn_map.send(msg.get_key_state());
-  m_abs_map.send(msg.get_key_state(), msg.get_abs_state(), msg.get_abs_min(), msg.get_abs_max());
+  m_btn_map.send(msg);
+  m_abs_map.send(msg);
 
   m_uinput.sync();
 }
 
 void
-EventEmitter::update(int msec_delta)
+EventEmitter::update(int usec_delta)
 {
-  m_btn_map.update(msec_delta);
-  m_abs_map.update(msec_delta);
+  m_btn_map.update(usec_delta);
+  m_abs_map.update(usec_delta);
 
   m_uinput.sync();
 }
 
+int
+EventEmitter::get_next_update() const
+{
+  return earliest_update(m_btn_map.get_next_update(),
+                         m_abs_map.get_next_update());
+}
+
 void
 EventEmitter::reset_all_outputs()
 {
@@ -44,7 +44,10 @@ public:
 
   void init(const ControllerMessageDescriptor& desc);
   void send(const ControllerMessage& msg); 
-  void update(int msec_delta);
+  void update(int usec_delta);
+
+  /** msec until update() has to be called again, -1 if never */
+  int get_next_update() const;
 
   void reset_all_outputs();
 
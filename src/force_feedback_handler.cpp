@@ -395,6 +395,19 @@ ForceFeedbackHandler::update(int msec_delta)
   }
 }
 
+bool
+ForceFeedbackHandler::is_playing() const
+{
+  for(Effects::const_iterator i = effects.begin(); i != effects.end(); ++i)
+  {
+    if (i->second.playing)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 int
 ForceFeedbackHandler::get_weak_magnitude() const
 {
@@ -108,6 +108,9 @@ public:
 
   void update(int msec_delta);
 
+  /** true while any effect is playing and update() has to be called */
+  bool is_playing() const;
+
   int get_weak_magnitude() const;
   int get_strong_magnitude() const;
 };
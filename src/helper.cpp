@@ -202,6 +202,27 @@ uint32_t get_time()
   gettimeofday(&tv, NULL);
   return tv.tv_sec * 1000 + tv.tv_usec/1000;
 }
+
+int earliest_update(int lhs, int rhs)
+{
+  if (lhs < 0)
+  {
+    return rhs;
+  }
+  else if (rhs < 0)
+  {
+    return lhs;
+  }
+  else
+  {
+    return std::min(lhs, rhs);
+  }
+}
+
+int usec_to_msec_ceil(int usec)
+{
+  return (std::max(0, usec) + 999) / 1000;
+}
 
 float to_float_no_range_check(int value, int min, int max)
 {
@@ -53,6 +53,14 @@ void split_string_at(const std::string& str, char c, std::string* lhs, std::stri
 */
 int to_number(int range, const std::string& str);
 uint32_t get_time();
+
+/** Combines two deadlines as returned by get_next_update(), -1
+    stands for no deadline at all */
+int earliest_update(int lhs, int rhs);
+
+/** Converts a remaining time in usec into a get_next_update() value,
+    rounding up so that the deadline has passed when the update runs */
+int usec_to_msec_ceil(int usec);
 
 namespace Math {
 template<class T>
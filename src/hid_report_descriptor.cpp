@@ -0,0 +1,401 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "hid_report_descriptor.hpp"
+
+#include <algorithm>
+#include <linux/input.h>
+#include <set>
+#include <sstream>
+
+#include "evdev_helper.hpp"
+#include "log.hpp"
+
+namespace {
+
+// usage pages and usages, see the HID Usage Tables
+const uint32_t kUsageGamepad       = 0x00010005;
+const uint32_t kPageGenericDesktop = 0x0001;
+const uint32_t kPageSimulation     = 0x0002;
+const uint32_t kPageButton         = 0x0009;
+
+struct GlobalState
+{
+  uint32_t usage_page;
+  int32_t  logical_min;
+  int32_t  logical_max;
+  uint32_t logical_max_raw; // logical_max read as unsigned
+  uint32_t report_size;
+  uint32_t report_count;
+  uint32_t report_id;
+
+  GlobalState() :
+    usage_page(0),
+    logical_min(0),
+    logical_max(0),
+    logical_max_raw(0),
+    report_size(0),
+    report_count(0),
+    report_id(0)
+  {}
+};
+
+/** Assigns names to fields in the way the kernel hid-input driver
+    assigns evdev codes, every code is only handed out once */
+class UsageMapper
+{
+private:
+  std::set<int> m_used_abs;
+  std::set<int> m_used_key;
+  int m_hats;
+
+public:
+  UsageMapper() :
+    m_used_abs(),
+    m_used_key(),
+    m_hats(0)
+  {}
+
+  bool map(uint32_t usage, uint32_t application, ReportField& field)
+  {
+    const uint32_t page = usage >> 16;
+    const uint32_t id   = usage & 0xffff;
+
+    if (page == kPageButton)
+    {
+      int code;
+      if (id >= 1 && id <= 16)
+      {
+        code = ((application == kUsageGamepad) ? BTN_GAMEPAD : BTN_JOYSTICK) + static_cast<int>(id) - 1;
+      }
+      else if (id >= 17 && id <= 56)
+      {
+        code = BTN_TRIGGER_HAPPY + static_cast<int>(id) - 17;
+      }
+      else
+      {
+        return false;
+      }
+
+      if (field.width != 1 || !m_used_key.insert(code).second)
+      {
+        return false;
+      }
+
+      field.kind = ReportField::kKey;
+      field.name = "evdev." + key2str(code);
+      return true;
+    }
+    else if (page == kPageGenericDesktop && id == 0x39)
+    {
+      if (m_hats >= 4)
+      {
+        return false;
+      }
+
+      std::ostringstream name;
+      name << "evdev.ABS_HAT" << m_hats;
+      m_hats += 1;
+
+      field.kind = ReportField::kHatAxes;
+      field.name = name.str();
+      return true;
+    }
+    else
+    {
+      int code = -1;
+      if (page == kPageGenericDesktop)
+      {
+        switch(id)
+        {
+          case 0x30: code = ABS_X; break;
+          case 0x31: code = ABS_Y; break;
+          case 0x32: code = ABS_Z; break;
+          case 0x33: code = ABS_RX; break;
+          case 0x34: code = ABS_RY; break;
+          case 0x35: code = ABS_RZ; break;
+          case 0x36: code = ABS_THROTTLE; break; // slider
+          case 0x37: code = ABS_RUDDER; break;   // dial
+          case 0x38: code = ABS_WHEEL; break;
+        }
+      }
+      else if (page == kPageSimulation)
+      {
+        switch(id)
+        {
+          case 0xba: code = ABS_RUDDER; break;
+          case 0xbb: code = ABS_THROTTLE; break;
+          case 0xc4: code = ABS_GAS; break;
+          case 0xc5: code = ABS_BRAKE; break;
+        }
+      }
+
+      if (code == -1 || !m_used_abs.insert(code).second)
+      {
+        return false;
+      }
+
+      field.kind = ReportField::kAbs;
+      field.name = "evdev." + abs2str(code);
+      return true;
+    }
+  }
+};
+
+} // namespace
+
+HIDReportDescriptor::HIDReportDescriptor(const uint8_t* data, int len) :
+  m_reports()
+{
+  GlobalState global;
+  std::vector<GlobalState> global_stack;
+
+  std::vector<uint32_t> usages;
+  uint32_t usage_min = 0;
+  uint32_t usage_max = 0;
+  bool has_usage_range = false;
+
+  uint32_t application = 0;
+  UsageMapper mapper;
+
+  int pos = 0;
+  while(pos < len)
+  {
+    const uint8_t prefix = data[pos];
+
+    if (prefix == 0xfe)
+    {
+      // long item, not used by any defined item type
+      if (pos + 1 >= len) break;
+      pos += 3 + data[pos + 1];
+      continue;
+    }
+
+    const int size = ((prefix & 0x3) == 3) ? 4 : (prefix & 0x3);
+    const int type = (prefix >> 2) & 0x3;
+    const int tag  = (prefix >> 4) & 0xf;
+
+    if (pos + 1 + size > len)
+    {
+      log_warn("truncated HID report descriptor");
+      break;
+    }
+
+    uint32_t udata = 0;
+    for(int i = 0; i < size; ++i)
+    {
+      udata |= static_cast<uint32_t>(data[pos + 1 + i]) << (8 * i);
+    }
+
+    int32_t sdata;
+    switch(size)
+    {
+      case 1:  sdata = static_cast<int8_t>(udata); break;
+      case 2:  sdata = static_cast<int16_t>(udata); break;
+      default: sdata = static_cast<int32_t>(udata); break;
+    }
+
+    pos += 1 + size;
+
+    switch(type)
+    {
+      case 0: // main
+        if (tag == 0x8) // Input
+        {
+          Report& report = get_report(global.report_id);
+          const bool constant = udata & 0x1;
+          const bool variable = udata & 0x2;
+          const uint32_t total = global.report_size * global.report_count;
+
+          if (constant || !variable || global.report_size == 0 || global.report_count > 1024)
+          {
+            // padding, arrays and anything else that can't be mapped
+            // to a fixed field
+            report.bits += total;
+          }
+          else
+          {
+            // many descriptors give unsigned ranges with a one byte
+            // maximum like 0xff, which would read as -1
+            int32_t logical_max = global.logical_max;
+            if (global.logical_min >= 0 && logical_max < global.logical_min)
+            {
+              logical_max = static_cast<int32_t>(global.logical_max_raw);
+            }
+
+            for(uint32_t i = 0; i < global.report_count; ++i)
+            {
+              const int bitpos = report.bits;
+              report.bits += global.report_size;
+
+              uint32_t usage;
+              if (i < usages.size())
+              {
+                usage = usages[i];
+              }
+              else if (has_usage_range)
+              {
+                usage = std::min(usage_min + (i - static_cast<uint32_t>(usages.size())), usage_max);
+              }
+              else if (!usages.empty())
+              {
+                usage = usages.back();
+              }
+              else
+              {
+                continue;
+              }
+
+              ReportField field;
+              field.byte  = bitpos / 8;
+              field.bit   = bitpos % 8;
+              field.width = global.report_size;
+              field.is_signed = (global.logical_min < 0);
+
+              if (field.width > (field.is_signed ? 32 : 31) ||
+                  !mapper.map(usage, application, field))
+              {
+                continue;
+              }
+
+              if (global.logical_min < logical_max)
+              {
+                field.out_min = global.logical_min;
+                field.out_max = logical_max;
+              }
+              else
+              {
+                field.out_min = field.raw_min();
+                field.out_max = field.raw_max();
+              }
+
+              report.fields.push_back(field);
+            }
+          }
+        }
+        else if (tag == 0xa) // Collection
+        {
+          if (udata == 0x01 && !usages.empty()) // Application
+          {
+            application = usages.front();
+          }
+        }
+
+        // locals only apply to the next main item
+        usages.clear();
+        has_usage_range = false;
+        break;
+
+      case 1: // global
+        switch(tag)
+        {
+          case 0x0: global.usage_page   = udata; break;
+          case 0x1: global.logical_min  = sdata; break;
+          case 0x2:
+            global.logical_max     = sdata;
+            global.logical_max_raw = udata;
+            break;
+          case 0x7: global.report_size  = udata; break;
+          case 0x8: global.report_id    = udata; break;
+          case 0x9: global.report_count = udata; break;
+          case 0xa: global_stack.push_back(global); break;
+          case 0xb:
+            if (!global_stack.empty())
+            {
+              global = global_stack.back();
+              global_stack.pop_back();
+            }
+            break;
+        }
+        break;
+
+      case 2: // local
+        {
+          // short usages are relative to the current usage page
+          const uint32_t usage = (size == 4) ? udata : ((global.usage_page << 16) | udata);
+          switch(tag)
+          {
+            case 0x0: usages.push_back(usage); break;
+            case 0x1: usage_min = usage; has_usage_range = true; break;
+            case 0x2: usage_max = usage; has_usage_range = true; break;
+          }
+        }
+        break;
+    }
+  }
+}
+
+HIDReportDescriptor::Report&
+HIDReportDescriptor::get_report(int id)
+{
+  for(std::vector<Report>::iterator i = m_reports.begin(); i != m_reports.end(); ++i)
+  {
+    if (i->id == id)
+    {
+      return *i;
+    }
+  }
+
+  m_reports.push_back(Report(id));
+  return m_reports.back();
+}
+
+const HIDReportDescriptor::Report*
+HIDReportDescriptor::get_best_report() const
+{
+  const Report* best = 0;
+  for(std::vector<Report>::const_iterator i = m_reports.begin(); i != m_reports.end(); ++i)
+  {
+    if (!best || i->fields.size() > best->fields.size())
+    {
+      best = &*i;
+    }
+  }
+  return best;
+}
+
+std::vector<ReportField>
+HIDReportDescriptor::get_layout() const
+{
+  const Report* report = get_best_report();
+  if (report)
+  {
+    return report->fields;
+  }
+  else
+  {
+    return std::vector<ReportField>();
+  }
+}
+
+int
+HIDReportDescriptor::get_report_id() const
+{
+  const Report* report = get_best_report();
+  if (report && report->id != 0)
+  {
+    return report->id;
+  }
+  else
+  {
+    return -1;
+  }
+}
+
+/* EOF */
@@ -0,0 +1,64 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_HID_REPORT_DESCRIPTOR_HPP
+#define HEADER_XBOXDRV_HID_REPORT_DESCRIPTOR_HPP
+
+#include <stdint.h>
+#include <vector>
+
+#include "report_parser.hpp"
+
+/** Minimal USB HID report descriptor parser. It walks the items of
+    the descriptor and turns the variable input fields of the largest
+    input report into a ReportField layout, naming buttons, axes and
+    hats after the evdev codes the kernel hid driver would assign. */
+class HIDReportDescriptor
+{
+private:
+  struct Report
+  {
+    int id;
+    int bits;
+    std::vector<ReportField> fields;
+
+    Report(int id_) : id(id_), bits(id_ ? 8 : 0), fields() {}
+  };
+
+  std::vector<Report> m_reports;
+
+public:
+  HIDReportDescriptor(const uint8_t* data, int len);
+
+  /** Layout of the input report with the most usable fields, empty
+      if the descriptor has none */
+  std::vector<ReportField> get_layout() const;
+
+  /** The report id that get_layout() belongs to, -1 if the device
+      doesn't use report ids */
+  int get_report_id() const;
+
+private:
+  Report& get_report(int id);
+  const Report* get_best_report() const;
+};
+
+#endif
+
+/* EOF */
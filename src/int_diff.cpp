@@ -0,0 +1,76 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "int_diff.hpp"
+
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#elif defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+bool
+int_diff(const int* lhs, const int* rhs, int count, uint32_t* mask)
+{
+  uint32_t any = 0;
+  int i = 0;
+
+  // the vector loops advance in steps that divide 32, so the bits of
+  // one step never straddle two mask words
+#if defined(__AVX2__)
+  for(; i + 8 <= count; i += 8)
+  {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+    uint32_t ne = ~static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))) & 0xffu;
+    if (ne)
+    {
+      mask[i / 32] |= ne << (i % 32);
+      any |= ne;
+    }
+  }
+#endif
+
+#if defined(__SSE2__)
+  for(; i + 4 <= count; i += 4)
+  {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+    uint32_t ne = ~static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))) & 0xfu;
+    if (ne)
+    {
+      mask[i / 32] |= ne << (i % 32);
+      any |= ne;
+    }
+  }
+#endif
+
+  for(; i < count; ++i)
+  {
+    if (lhs[i] != rhs[i])
+    {
+      mask[i / 32] |= 1u << (i % 32);
+      any = 1;
+    }
+  }
+
+  return any != 0;
+}
+
+/* EOF */
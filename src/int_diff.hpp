@@ -0,0 +1,39 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_INT_DIFF_HPP
+#define HEADER_XBOXDRV_INT_DIFF_HPP
+
+#include <stdint.h>
+
+/** Number of mask words int_diff() needs for \a count entries */
+inline int int_diff_words(int count) { return (count + 31) / 32; }
+
+/** Compare the first \a count entries of \a lhs and \a rhs and set
+    bit i of \a mask (32 entries per word) for every entry that
+    differs. Bits are only ever set, never cleared, so several arrays
+    can be folded into one mask. Returns true if any entry differed.
+
+    Uses AVX2 or SSE2 when the compiler targets them and a plain loop
+    otherwise. */
+bool int_diff(const int* lhs, const int* rhs, int count, uint32_t* mask);
+
+#endif
+
+/* EOF */
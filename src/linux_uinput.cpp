@@ -43,6 +43,8 @@ LinuxUinput::LinuxUinput(DeviceType device_type, const std::string& name_,
   ff_bit(false),
   m_ff_handler(0),
   m_ff_callback(),
+  m_ff_dirty(false),
+  m_update_callback(),
   needs_sync(true)
 {
   log_debug(name << " " << usbid.vendor << ":" << usbid.product);
@@ -184,6 +186,12 @@ LinuxUinput::set_ff_callback(const boost::function<void (uint8_t, uint8_t)>& cal
   m_ff_callback = callback;
 }
 
+void
+LinuxUinput::set_update_callback(const boost::function<void ()>& callback)
+{
+  m_update_callback = callback;
+}
+
 void
 LinuxUinput::finish()
 {
@@ -321,6 +329,7 @@ LinuxUinput::update(int msec_delta)
     assert(m_ff_handler);
 
     m_ff_handler->update(msec_delta);
+    m_ff_dirty = false;
 
     log_info(boost::format("%5d %5d") % m_ff_handler->get_strong_magnitude() % m_ff_handler->get_weak_magnitude());
 
@@ -332,6 +341,12 @@ LinuxUinput::update(int msec_delta)
   }
 }
 
+bool
+LinuxUinput::needs_update() const
+{
+  return ff_bit && (m_ff_dirty || m_ff_handler->is_playing());
+}
+
 gboolean
 LinuxUinput::on_read_data(GIOChannel* source, GIOCondition condition)
 {
@@ -363,6 +378,7 @@ LinuxUinput::on_read_data(GIOChannel* source, GIOCondition condition)
             else
               m_ff_handler->stop(ev.code);
         }
+        m_ff_dirty = true;
         break;
 
       case EV_UINPUT:
@@ -416,6 +432,11 @@ LinuxUinput::on_read_data(GIOChannel* source, GIOCondition condition)
     }
   }
 
+  if (m_ff_dirty && m_update_callback)
+  {
+    m_update_callback();
+  }
+
   if (ret == 0)
   {
     // ok, no more data
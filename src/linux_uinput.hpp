@@ -57,6 +57,10 @@ private:
   ForceFeedbackHandler* m_ff_handler;
   boost::function<void (uint8_t, uint8_t)> m_ff_callback;
 
+  /** force feedback changed since the last update() */
+  bool m_ff_dirty;
+  boost::function<void ()> m_update_callback;
+
   bool needs_sync;
 
 public:
@@ -78,6 +82,10 @@ public:
 
   void set_ff_callback(const boost::function<void (uint8_t, uint8_t)>& callback);
 
+  /** \a callback is called when force feedback events arrive and
+      update() has to be called again */
+  void set_update_callback(const boost::function<void ()>& callback);
+
   /** Finalized the device creation */
   void finish();
   /*@}*/
@@ -89,6 +97,10 @@ public:
 
   void update(int msec_delta);
 
+  /** true while force feedback is playing or has changed and update()
+      has to be called */
+  bool needs_update() const;
+
 private:
   gboolean on_read_data(GIOChannel* source,
                         GIOCondition condition);
@@ -18,6 +18,7 @@
 
 #include "message_processor.hpp"
 
+#include "helper.hpp"
 #include "log.hpp"
 #include "uinput.hpp"
 
@@ -26,8 +27,10 @@ MessageProcessor::MessageProcessor(ControllerSlotConfigPtr config,
                                    const Options& opts) :
   m_config(config),
   m_desc(desc),
-  m_oldmsg(),
+  m_msgs(),
+  m_current(0),
   m_config_toggle_button(-1),
+  m_config_switched(false),
   m_rumble_gain(opts.rumble_gain),
   m_rumble_test(opts.rumble),
   m_rumble_callback()
@@ -37,11 +40,11 @@ MessageProcessor::MessageProcessor(ControllerSlotConfigPtr config,
     m_config_toggle_button = desc.key().get(opts.config_toggle_button);
   }
 
-  for(std::vector<ModifierPtr>::iterator i = m_config->get_config()->get_modifier().begin();
-      i != m_config->get_config()->get_modifier().end();
-      ++i)
+  // all modifiers have to register their outputs before the
+  // emitters look them up
+  for(int i = 0; i < m_config->config_count(); ++i)
   {
-    (*i)->init(m_desc);
+    m_config->get_config(i)->init_modifier(m_desc);
   }
 
   for(int i = 0; i < m_config->config_count(); ++i)
@@ -57,11 +60,15 @@ MessageProcessor::~MessageProcessor()
 void
 MessageProcessor::send(const ControllerMessage& msg_in, 
                        const ControllerMessageDescriptor& msg_desc, 
-                       int msec_delta)
+                       int usec_delta)
 {
   if (m_config && !m_config->empty())
   {
-    ControllerMessage msg = msg_in; 
+    ControllerMessage& msg = m_msgs[m_current];
+    const ControllerMessage& oldmsg = m_msgs[m_current ^ 1];
+
+    // the input has to stay untouched, it is resend on every timeout
+    msg = msg_in;
 
 #if 0
     if (m_rumble_test)
@@ -76,7 +83,7 @@ MessageProcessor::send(const ControllerMessage& msg_in,
     // handling switching of configurations
     if (m_config_toggle_button != -1)
     {
-      bool last = m_oldmsg.get_key(m_config_toggle_button);
+      bool last = oldmsg.get_key(m_config_toggle_button);
       bool cur  = msg.get_key(m_config_toggle_button);
 
       if (cur && cur != last)
@@ -86,32 +93,65 @@ MessageProcessor::send(const ControllerMessage& msg_in,
 
         // switch to the next input mapping
         m_config->next_config();
+        m_config_switched = true;
 
         log_info("switched to config: " << m_config->get_current_config());
       }
     }
 
     // run the controller message through all modifier
-    for(std::vector<ModifierPtr>::iterator i = m_config->get_config()->get_modifier().begin();
-        i != m_config->get_config()->get_modifier().end(); 
-        ++i)
-    {
-      (*i)->update(msec_delta, msg, m_desc);
-    }
+    m_config->get_config()->get_modifier_program().run(usec_delta, msg, m_desc);
 
-    m_config->get_config()->get_emitter().update(msec_delta);
+    m_config->get_config()->get_emitter().update(usec_delta);
 
     // send current Xbox state to uinput
-    if (msg != m_oldmsg)
+    bool changed = msg.update_changes(oldmsg);
+    if (m_config_switched)
+    {
+      // the emitter of the new config has not seen any of the
+      // current state yet
+      msg.mark_all_changed();
+      changed = true;
+      m_config_switched = false;
+    }
+
+    if (changed)
     {
       // Only send a new event out if something has changed,
       // this is useful since some controllers send events
       // even if nothing has changed, deadzone can cause this
       // too
-      m_oldmsg = msg;
-
       m_config->get_config()->get_emitter().send(msg);
+
+      // msg becomes the last send message, no copy needed
+      m_current ^= 1;
+    }
+  }
+}
+
+int
+MessageProcessor::get_next_update() const
+{
+  if (!m_config || m_config->empty())
+  {
+    return -1;
+  }
+  else if (m_config_switched)
+  {
+    // the new config still has to see the current state
+    return 0;
+  }
+  else
+  {
+    int next = m_config->get_config()->get_emitter().get_next_update();
+
+    const std::vector<ModifierPtr>& modifier = m_config->get_config()->get_modifier();
+    for(std::vector<ModifierPtr>::const_iterator i = modifier.begin(); i != modifier.end(); ++i)
+    {
+      next = earliest_update(next, (*i)->get_next_update());
     }
+
+    return next;
   }
 }
 
@@ -136,6 +176,7 @@ MessageProcessor::set_config(int num)
     m_config->get_config()->get_emitter().reset_all_outputs();
 
     m_config->set_current_config(num);
+    m_config_switched = true;
 
     log_info("switched to config: " << m_config->get_current_config());
   }
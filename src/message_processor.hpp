@@ -31,8 +31,12 @@ private:
   ControllerSlotConfigPtr m_config;
 
   ControllerMessageDescriptor m_desc;
-  ControllerMessage m_oldmsg; /// last data send to uinput
+  /** double buffer: the current message is built in one, the other
+      holds the last data send to uinput, they swap roles on send */
+  ControllerMessage m_msgs[2];
+  int m_current;
   int m_config_toggle_button;
+  bool m_config_switched; /// force a full send after a config change
 
   int m_rumble_gain;
   bool m_rumble_test;
@@ -46,7 +50,13 @@ public:
 
   void send(const ControllerMessage& msg,
             const ControllerMessageDescriptor& msg_desc,
-            int msec_delta);
+            int usec_delta);
+
+  /** Returns the msec until send() has to be called again with the
+      last message, 0 for the next tick or -1 when all modifiers and
+      events are idle and nothing would change */
+  int get_next_update() const;
+
   void set_rumble(uint8_t lhs, uint8_t rhs);
   void set_ff_callback(const boost::function<void (uint8_t, uint8_t)>& callback);
   void set_config(int num);
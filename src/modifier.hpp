@@ -26,6 +26,7 @@
 
 class Modifier;
 class Options;
+struct ModifierOp;
 
 typedef boost::shared_ptr<Modifier> ModifierPtr;
 
@@ -50,7 +51,17 @@ public:
   virtual ~Modifier() {}
 
   virtual void init(ControllerMessageDescriptor& desc) = 0;
-  virtual void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc) = 0;
+  virtual void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc) = 0;
+
+  /** Returns the msec until update() has to be called again, even
+      without new input, 0 for the next tick or -1 when the modifier
+      has no time dependent state */
+  virtual int get_next_update() const { return -1; }
+
+  /** Describes the modifier as a ModifierOp, so that ModifierProgram
+      can run it without a virtual call. Called after init(), returns
+      false if the modifier has to go through update(). */
+  virtual bool compile(ModifierOp* op) const { return false; }
 
   virtual std::string str() const = 0;
 };
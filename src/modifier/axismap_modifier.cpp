@@ -66,7 +66,7 @@ AxisMapping::from_string(const std::string& lhs_, const std::string& rhs)
   AxisMappingPtr mapping(new AxisMapping(lhs_str, rhs_str, invert));
   for(std::vector<std::string>::size_type i = 1; i < tks.size(); ++i)
   {
-    mapping->filters.push_back(AxisFilter::from_string(tks[i]));
+    mapping->filters.add(AxisFilter::from_string(tks[i]));
   }
   return mapping;
 }
@@ -118,17 +118,14 @@ AxismapModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-AxismapModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+AxismapModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   ControllerMessage newmsg = msg;
 
   // update all filters in all mappings
   for(std::vector<AxisMappingPtr>::iterator i = m_axismap.begin(); i != m_axismap.end(); ++i)
   {
-    for(std::vector<AxisFilterPtr>::iterator j = (*i)->filters.begin(); j != (*i)->filters.end(); ++j)
-    {
-      (*j)->update(msec_delta);
-    }
+    (*i)->filters.update(usec_delta);
   }
 
   // clear all lhs values in the newmsg, keep rhs
@@ -149,10 +146,7 @@ AxismapModifier::update(int msec_delta, ControllerMessage& msg, const Controller
       value = inv.filter(value, min, max);
     }
 
-    for(std::vector<AxisFilterPtr>::iterator j = (*i)->filters.begin(); j != (*i)->filters.end(); ++j)
-    {
-      value = (*j)->filter(value, min, max);
-    }
+    value = (*i)->filters.filter(value, min, max);
 
     float lhs = to_float(value, min, max);
 
@@ -172,6 +166,17 @@ AxismapModifier::update(int msec_delta, ControllerMessage& msg, const Controller
   msg = newmsg;
 }
 
+int
+AxismapModifier::get_next_update() const
+{
+  int next = -1;
+  for(std::vector<AxisMappingPtr>::const_iterator i = m_axismap.begin(); i != m_axismap.end(); ++i)
+  {
+    next = earliest_update(next, (*i)->filters.get_next_update());
+  }
+  return next;
+}
+
 void
 AxismapModifier::add(AxisMappingPtr mapping)
 {
@@ -186,7 +191,7 @@ AxismapModifier::str() const
   for(std::vector<AxisMappingPtr>::const_iterator i = m_axismap.begin(); i != m_axismap.end(); ++i)
   {
     out << "  " << (*i)->lhs.str() << "=" << (*i)->rhs.str() << std::endl;
-    for(std::vector<AxisFilterPtr>::const_iterator filter = (*i)->filters.begin();
+    for(AxisFilterChain::const_iterator filter = (*i)->filters.begin();
         filter != (*i)->filters.end(); ++filter)
     {
       out << "    " << (*filter)->str() << std::endl;
@@ -20,7 +20,7 @@
 #define HEADER_XBOXDRV_MODIFIER_AXISMAP_MODIFIER_HPP
 
 #include "abs_port.hpp"
-#include "axis_filter.hpp"
+#include "axis_filter_chain.hpp"
 #include "controller_message.hpp"
 #include "controller_thread.hpp"
 #include "modifier.hpp"
@@ -47,7 +47,7 @@ struct AxisMapping
   AbsPortIn  lhs;
   AbsPortOut rhs;
   bool invert;
-  std::vector<AxisFilterPtr> filters;
+  AxisFilterChain filters;
 
   AxisMapping(const std::string& lhs_, const std::string& rhs_, bool invert_) :
     lhs(lhs_),
@@ -70,7 +70,8 @@ public:
   AxismapModifier();
 
   void init(ControllerMessageDescriptor& desc);
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  int get_next_update() const;
 
   void add(AxisMappingPtr mapping);
 
@@ -125,14 +125,14 @@ ButtonmapModifier::init(ControllerMessageDescriptor& desc)
 }
   
 void
-ButtonmapModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+ButtonmapModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   // update all filters in all mappings
   for(std::vector<ButtonMappingPtr>::iterator i = m_buttonmap.begin(); i != m_buttonmap.end(); ++i)
   {
     for(std::vector<ButtonFilterPtr>::iterator j = (*i)->filters.begin(); j != (*i)->filters.end(); ++j)
     {
-      (*j)->update(msec_delta);
+      (*j)->update(usec_delta);
     }
   }
 
@@ -155,6 +155,20 @@ ButtonmapModifier::update(int msec_delta, ControllerMessage& msg, const Controll
   msg.set_key_state(state);
 }
 
+int
+ButtonmapModifier::get_next_update() const
+{
+  int next = -1;
+  for(std::vector<ButtonMappingPtr>::const_iterator i = m_buttonmap.begin(); i != m_buttonmap.end(); ++i)
+  {
+    for(std::vector<ButtonFilterPtr>::const_iterator j = (*i)->filters.begin(); j != (*i)->filters.end(); ++j)
+    {
+      next = earliest_update(next, (*j)->get_next_update());
+    }
+  }
+  return next;
+}
+
 void
 ButtonmapModifier::add(ButtonMappingPtr mapping)
 {
@@ -50,7 +50,8 @@ public:
   ButtonmapModifier();
 
   void init(ControllerMessageDescriptor& desc);  
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  int get_next_update() const;
 
   void add(ButtonMappingPtr mapping);
   void add_filter(const std::string& btn, ButtonFilterPtr filter);
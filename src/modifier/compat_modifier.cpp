@@ -76,7 +76,7 @@ CompatModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-CompatModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+CompatModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   if (m_dpad)
   {
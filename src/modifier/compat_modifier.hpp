@@ -41,7 +41,7 @@ public:
   CompatModifier();
 
   void init(ControllerMessageDescriptor& desc);
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
 
   std::string str() const;
 
@@ -21,6 +21,7 @@
 #include <boost/tokenizer.hpp>
 #include <stdexcept>
 
+#include "modifier_program.hpp"
 #include "raise_exception.hpp"
 
 DpadRestrictorModifier*
@@ -55,15 +56,15 @@ DpadRestrictorModifier::DpadRestrictorModifier(Mode mode) :
   m_mode(mode),
   m_last_unpressed_axis(-1),
 
-  m_dpad_up("dpad_up"),
-  m_dpad_down("dpad_down"),
-  m_dpad_left("dpad_left"),
-  m_dpad_right("dpad_right"),
+  m_dpad_up("gamepad.dpad_up"),
+  m_dpad_down("gamepad.dpad_down"),
+  m_dpad_left("gamepad.dpad_left"),
+  m_dpad_right("gamepad.dpad_right"),
 
-  m_dpad_up_out("dpad_up"),
-  m_dpad_down_out("dpad_down"),
-  m_dpad_left_out("dpad_left"),
-  m_dpad_right_out("dpad_right")
+  m_dpad_up_out("gamepad.dpad_up"),
+  m_dpad_down_out("gamepad.dpad_down"),
+  m_dpad_left_out("gamepad.dpad_left"),
+  m_dpad_right_out("gamepad.dpad_right")
 {
 }
 
@@ -84,7 +85,7 @@ DpadRestrictorModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-DpadRestrictorModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+DpadRestrictorModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
 #if 0
   switch(m_mode)
@@ -117,6 +118,14 @@ DpadRestrictorModifier::update(int msec_delta, ControllerMessage& msg, const Con
 #endif
 }
 
+bool
+DpadRestrictorModifier::compile(ModifierOp* op) const
+{
+  // update() doesn't do anything at the moment
+  op->opcode = ModifierOp::kOpNop;
+  return true;
+}
+
 std::string
 DpadRestrictorModifier::str() const
 {
@@ -41,7 +41,8 @@ public:
   DpadRestrictorModifier(Mode mode);
 
   void init(ControllerMessageDescriptor& desc);
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  bool compile(ModifierOp* op) const;
   std::string str() const;
 
 private:
@@ -22,6 +22,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include "controller_config.hpp"
+#include "modifier_program.hpp"
 
 DpadRotationModifier*
 DpadRotationModifier::from_string(const std::vector<std::string>& args)
@@ -51,15 +52,15 @@ DpadRotationModifier::from_string(const std::string& value)
 DpadRotationModifier::DpadRotationModifier(int dpad_rotation) :
   m_dpad_rotation(dpad_rotation),
 
-  m_dpad_up("dpad_up"),
-  m_dpad_down("dpad_down"),
-  m_dpad_left("dpad_left"),
-  m_dpad_right("dpad_right"),
+  m_dpad_up("gamepad.dpad_up"),
+  m_dpad_down("gamepad.dpad_down"),
+  m_dpad_left("gamepad.dpad_left"),
+  m_dpad_right("gamepad.dpad_right"),
 
-  m_dpad_up_out("dpad_up"),
-  m_dpad_down_out("dpad_down"),
-  m_dpad_left_out("dpad_left"),
-  m_dpad_right_out("dpad_right")
+  m_dpad_up_out("gamepad.dpad_up"),
+  m_dpad_down_out("gamepad.dpad_down"),
+  m_dpad_left_out("gamepad.dpad_left"),
+  m_dpad_right_out("gamepad.dpad_right")
 {
 }
 
@@ -70,16 +71,16 @@ DpadRotationModifier::init(ControllerMessageDescriptor& desc)
   m_dpad_down.init(desc);
   m_dpad_left.init(desc);
   m_dpad_right.init(desc);
+
+  m_dpad_up_out.init(desc);
+  m_dpad_down_out.init(desc);
+  m_dpad_left_out.init(desc);
+  m_dpad_right_out.init(desc);
 }
 
-void
-DpadRotationModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+bool
+DpadRotationModifier::rotate(int rotation, bool& up, bool& down, bool& left, bool& right)
 {
-  int up   = m_dpad_up.get(msg);
-  int down = m_dpad_down.get(msg);
-  int left = m_dpad_left.get(msg);
-  int right= m_dpad_right.get(msg);
-
   // -1: not pressed, 0: up, 1: up/right, ...
   int direction = -1;
   if (up && !down && !left && !right)
@@ -115,61 +116,60 @@ DpadRotationModifier::update(int msec_delta, ControllerMessage& msg, const Contr
     direction = 7;
   }
 
-  if (direction != -1)
-  {  
-    direction += m_dpad_rotation;
+  if (direction == -1)
+  {
+    return false;
+  }
+  else
+  {
+    direction += rotation;
     direction %= 8;
     if (direction < 0)
       direction += 8;
 
-    // set everything to zero
-    m_dpad_up_out.set(msg, 0);
-    m_dpad_down_out.set(msg, 0);
-    m_dpad_left_out.set(msg, 0);
-    m_dpad_right_out.set(msg, 0);
-
     // apply the given direction
-    switch(direction)
-    {
-      case 0:
-        m_dpad_up_out.set(msg, 1);
-        break;
-
-      case 1:
-        m_dpad_up_out.set(msg, 1);
-        m_dpad_right_out.set(msg, 1);
-        break;
-
-      case 2:
-        m_dpad_right_out.set(msg, 1);
-        break;
-
-      case 3:
-        m_dpad_right_out.set(msg, 1);
-        m_dpad_down_out.set(msg, 1);
-        break;
-
-      case 4:
-        m_dpad_down_out.set(msg, 1);
-        break;
-
-      case 5:
-        m_dpad_down_out.set(msg, 1);
-        m_dpad_left_out.set(msg, 1);
-        break;
-
-      case 6:
-        m_dpad_left_out.set(msg, 1);
-        break;
-
-      case 7:
-        m_dpad_up_out.set(msg, 1);
-        m_dpad_left_out.set(msg, 1);
-        break;
-    }
+    up    = (direction == 7 || direction == 0 || direction == 1);
+    right = (direction == 1 || direction == 2 || direction == 3);
+    down  = (direction == 3 || direction == 4 || direction == 5);
+    left  = (direction == 5 || direction == 6 || direction == 7);
+
+    return true;
   }
 }
 
+void
+DpadRotationModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+{
+  bool up    = m_dpad_up.get(msg);
+  bool down  = m_dpad_down.get(msg);
+  bool left  = m_dpad_left.get(msg);
+  bool right = m_dpad_right.get(msg);
+
+  if (rotate(m_dpad_rotation, up, down, left, right))
+  {
+    m_dpad_up_out.set(msg, up);
+    m_dpad_down_out.set(msg, down);
+    m_dpad_left_out.set(msg, left);
+    m_dpad_right_out.set(msg, right);
+  }
+}
+
+bool
+DpadRotationModifier::compile(ModifierOp* op) const
+{
+  op->opcode  = ModifierOp::kOpDpadRotation;
+  op->arg     = m_dpad_rotation;
+  op->slot[0] = m_dpad_up.get_key();
+  op->slot[1] = m_dpad_down.get_key();
+  op->slot[2] = m_dpad_left.get_key();
+  op->slot[3] = m_dpad_right.get_key();
+  op->slot[4] = m_dpad_up_out.get_key();
+  op->slot[5] = m_dpad_down_out.get_key();
+  op->slot[6] = m_dpad_left_out.get_key();
+  op->slot[7] = m_dpad_right_out.get_key();
+  return true;
+}
+
 std::string
 DpadRotationModifier::str() const
 {
@@ -32,6 +32,11 @@ public:
   static DpadRotationModifier* from_string(const std::vector<std::string>& args);
   static DpadRotationModifier* from_string(const std::string& value);
 
+  /** Rotates the dpad state by \a rotation steps of 45 degree in
+      place, returns false and leaves the buttons alone if they don't
+      form a single direction */
+  static bool rotate(int rotation, bool& up, bool& down, bool& left, bool& right);
+
 private:
   int  m_dpad_rotation;
 
@@ -49,7 +54,8 @@ public:
   DpadRotationModifier(int dpad_rotation);
 
   void init(ControllerMessageDescriptor& desc);
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  bool compile(ModifierOp* op) const;
 
   std::string str() const;
 
@@ -21,6 +21,8 @@
 #include <math.h>
 #include <sstream>
 #include <stdexcept>
+
+#include "modifier_program.hpp"
 
 FourWayRestrictorModifier*
 FourWayRestrictorModifier::from_string(const std::vector<std::string>& args)
@@ -58,7 +60,7 @@ FourWayRestrictorModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-FourWayRestrictorModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+FourWayRestrictorModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   if (fabsf(m_xaxis_in.get_float(msg)) > fabsf(m_yaxis_in.get_float(msg)))
   {
@@ -72,6 +74,17 @@ FourWayRestrictorModifier::update(int msec_delta, ControllerMessage& msg, const
   }
 }
 
+bool
+FourWayRestrictorModifier::compile(ModifierOp* op) const
+{
+  op->opcode  = ModifierOp::kOpFourWayRestrictor;
+  op->slot[0] = m_xaxis_in.get_abs();
+  op->slot[1] = m_yaxis_in.get_abs();
+  op->slot[2] = m_xaxis_out.get_abs();
+  op->slot[3] = m_yaxis_out.get_abs();
+  return true;
+}
+
 std::string
 FourWayRestrictorModifier::str() const
 {
@@ -34,7 +34,8 @@ public:
                             const std::string& xaxis_out, const std::string& yaxis_out);
 
   void init(ControllerMessageDescriptor& desc);
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  bool compile(ModifierOp* op) const;
 
   std::string str() const;
 
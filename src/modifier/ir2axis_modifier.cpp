@@ -52,7 +52,7 @@ IR2AxisModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-IR2AxisModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+IR2AxisModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
 #if 0
   // find center of two biggest points, return that as axis values
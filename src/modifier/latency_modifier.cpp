@@ -18,10 +18,15 @@
 
 #include "modifier/latency_modifier.hpp"
 
+#include <algorithm>
+#include <assert.h>
 #include <stdexcept>
 #include <iostream>
 #include <boost/lexical_cast.hpp>
 
+#include "controller_message_descriptor.hpp"
+#include "helper.hpp"
+#include "log.hpp"
 #include "raise_exception.hpp"
 
 LatencyModifier*
@@ -38,32 +43,202 @@ LatencyModifier::from_string(const std::vector<std::string>& args)
 }
 
 LatencyModifier::LatencyModifier(int latency) :
-  m_latency(latency),
+  m_latency(std::max(0, latency)),
   m_time(0),
-  m_messages(),
-  m_times()
+  m_primed(false),
+  m_input(),
+  m_output(),
+  // room for two changes per msec, more than a 1000Hz device produces
+  m_entries(2 * m_latency + 16),
+  m_entry_head(0),
+  m_entry_count(0),
+  // room for a single message changing every key, abs and rel slot,
+  // init() makes room for all entries
+  m_changes(256 + ControllerMessage::kMaxAbs + ControllerMessage::kMaxRel),
+  m_change_head(0),
+  m_change_count(0),
+  m_change_pending(0),
+  m_warned_early(false)
 {
 }
 
 void
 LatencyModifier::init(ControllerMessageDescriptor& desc)
 {
+  // every entry could change every slot the controller has
+  const int slots = desc.get_key_count() + desc.get_abs_count() + desc.get_rel_count();
+  const int capacity = static_cast<int>(m_entries.size()) * slots;
+
+  if (capacity > static_cast<int>(m_changes.size()))
+  {
+    m_changes.resize(capacity);
+  }
+}
+
+void
+LatencyModifier::push_change(Change::Type type, int slot, int value, int min, int max)
+{
+  const int capacity = static_cast<int>(m_changes.size());
+
+  while(m_change_count + m_change_pending >= capacity)
+  {
+    release_early();
+  }
+
+  Change& change = m_changes[(m_change_head + m_change_count + m_change_pending) % capacity];
+  change.type  = static_cast<uint8_t>(type);
+  change.slot  = static_cast<uint8_t>(slot);
+  change.value = value;
+  change.min   = min;
+  change.max   = max;
+
+  m_change_pending += 1;
+}
+
+void
+LatencyModifier::record(const ControllerMessage& msg)
+{
+  const std::bitset<256> keys = m_input.get_key_state() ^ msg.get_key_state();
+  if (keys.any())
+  {
+    for(int key = 0; key < 256; ++key)
+    {
+      if (keys[key])
+      {
+        push_change(Change::kKey, key, msg.get_key(key));
+      }
+    }
+    m_input.set_key_state(msg.get_key_state());
+  }
+
+  const int abs_count = std::max(m_input.get_abs_count(), msg.get_abs_count());
+  for(int abs = 0; abs < abs_count; ++abs)
+  {
+    const int value = msg.get_abs(abs);
+    const int min   = msg.get_abs_min(abs);
+    const int max   = msg.get_abs_max(abs);
+
+    if (value != m_input.get_abs(abs) ||
+        min   != m_input.get_abs_min(abs) ||
+        max   != m_input.get_abs_max(abs))
+    {
+      push_change(Change::kAbs, abs, value, min, max);
+      m_input.set_abs(abs, value, min, max);
+    }
+  }
+
+  const int rel_count = std::max(m_input.get_rel_count(), msg.get_rel_count());
+  for(int rel = 0; rel < rel_count; ++rel)
+  {
+    const int value = msg.get_rel(rel);
+    if (value != m_input.get_rel(rel))
+    {
+      push_change(Change::kRel, rel, value);
+      m_input.set_rel(rel, value);
+    }
+  }
+
+  if (m_change_pending > 0)
+  {
+    while(m_entry_count >= static_cast<int>(m_entries.size()))
+    {
+      release_early();
+    }
+
+    Entry& entry = m_entries[(m_entry_head + m_entry_count) % m_entries.size()];
+    entry.time  = m_time + static_cast<int64_t>(m_latency) * 1000;
+    entry.count = m_change_pending;
+
+    m_entry_count  += 1;
+    m_change_count += m_change_pending;
+    m_change_pending = 0;
+  }
+}
+
+void
+LatencyModifier::release_oldest()
+{
+  assert(m_entry_count > 0);
+
+  const Entry& entry = m_entries[m_entry_head];
+  for(int i = 0; i < entry.count; ++i)
+  {
+    const Change& change = m_changes[(m_change_head + i) % m_changes.size()];
+    switch(change.type)
+    {
+      case Change::kKey:
+        m_output.set_key(change.slot, change.value);
+        break;
+
+      case Change::kAbs:
+        m_output.set_abs(change.slot, change.value, change.min, change.max);
+        break;
+
+      case Change::kRel:
+        m_output.set_rel(change.slot, change.value);
+        break;
+    }
+  }
+
+  m_change_head   = (m_change_head + entry.count) % static_cast<int>(m_changes.size());
+  m_change_count -= entry.count;
+
+  m_entry_head   = (m_entry_head + 1) % static_cast<int>(m_entries.size());
+  m_entry_count -= 1;
 }
 
 void
-LatencyModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+LatencyModifier::release_early()
 {
-  m_time += msec_delta;
+  if (!m_warned_early)
+  {
+    log_warn("input changes faster than the latency buffer can hold, "
+             "some changes are delayed less than " << m_latency << " msec");
+    m_warned_early = true;
+  }
 
-  m_messages.push(msg);
-  m_times.push(m_time + m_latency);
+  release_oldest();
+}
+
+void
+LatencyModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+{
+  m_time += usec_delta;
 
-  msg = m_messages.front();
-  while(m_times.front() < m_time)
+  if (!m_primed)
+  {
+    // nothing older is known, so the first message serves as the
+    // state until the latency has passed
+    m_input  = msg;
+    m_output = msg;
+    m_primed = true;
+  }
+  else
+  {
+    record(msg);
+  }
+
+  while(m_entry_count > 0 && m_entries[m_entry_head].time <= m_time)
+  {
+    release_oldest();
+  }
+
+  const int64_t time = msg.get_time();
+  msg = m_output;
+  msg.set_time(time);
+}
+
+int
+LatencyModifier::get_next_update() const
+{
+  if (m_entry_count == 0)
+  {
+    return -1;
+  }
+  else
   {
-    m_times.pop();
-    msg = m_messages.front();
-    m_messages.pop();
+    // queued changes have to come out even without new input
+    return usec_to_msec_ceil(static_cast<int>(m_entries[m_entry_head].time - m_time));
   }
 }
 
@@ -19,30 +19,80 @@
 #ifndef HEADER_XBOXDRV_MODIFIER_LATENCY_MODIFIER_HPP
 #define HEADER_XBOXDRV_MODIFIER_LATENCY_MODIFIER_HPP
 
-#include <queue>
+#include <stdint.h>
+#include <vector>
 
 #include "modifier.hpp"
 
+/** Delays the message by a fixed amount of msec. Instead of queuing
+    full messages only the slots that changed are recorded, together
+    with the time they are due, in ring buffers that are sized from
+    the latency and the descriptor in init() and never grow. Should
+    the input change faster than the buffers can hold, the oldest
+    change goes out early. */
 class LatencyModifier : public Modifier
 {
 public:
   static LatencyModifier* from_string(const std::vector<std::string>& args);
 
+private:
+  struct Change
+  {
+    enum Type { kKey, kAbs, kRel };
+
+    uint8_t type;
+    uint8_t slot;
+    int value;
+    int min;
+    int max;
+  };
+
+  /** a set of changes that arrived together, its changes are stored
+      consecutively in m_changes */
+  struct Entry
+  {
+    int64_t time; /// usec at which the changes are due
+    int count;
+  };
+
 private:
   int m_latency;
-  int m_time;
-  std::queue<ControllerMessage> m_messages;
-  std::queue<int> m_times;
+  int64_t m_time; /// usec
+  bool m_primed;
+
+  /** the latest input, new messages are diffed against it */
+  ControllerMessage m_input;
+
+  /** the input as it was m_latency msec ago */
+  ControllerMessage m_output;
+
+  std::vector<Entry> m_entries;
+  int m_entry_head;
+  int m_entry_count;
+
+  std::vector<Change> m_changes;
+  int m_change_head;
+  int m_change_count;
+  int m_change_pending; /// changes written by record() but not yet part of an Entry
+
+  bool m_warned_early; /// an early release has been logged
 
 public:
   LatencyModifier(int latency);
   ~LatencyModifier() {}
 
   void init(ControllerMessageDescriptor& desc);
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  int get_next_update() const;
 
   std::string str() const;
 
+private:
+  void record(const ControllerMessage& msg);
+  void push_change(Change::Type type, int slot, int value, int min = 0, int max = 0);
+  void release_oldest();
+  void release_early();
+
 private:
   LatencyModifier(const LatencyModifier&);
   LatencyModifier& operator=(const LatencyModifier&);
@@ -38,7 +38,7 @@ LogModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-LogModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+LogModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   std::cout << m_prefix << ": ";
   for(int i = 0; i < desc.get_key_count(); ++i)
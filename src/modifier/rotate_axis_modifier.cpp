@@ -22,6 +22,8 @@
 #include <boost/lexical_cast.hpp>
 #include <math.h>
 
+#include "modifier_program.hpp"
+
 RotateAxisModifier*
 RotateAxisModifier::from_string(const std::vector<std::string>& args)
 {
@@ -55,7 +57,7 @@ RotateAxisModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-RotateAxisModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+RotateAxisModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   float x = msg.get_abs_float(m_xaxis);
   float y = msg.get_abs_float(m_yaxis);
@@ -72,6 +74,17 @@ RotateAxisModifier::update(int msec_delta, ControllerMessage& msg, const Control
   msg.set_abs_float(m_yaxis, sinf(angle) * length);
 }
 
+bool
+RotateAxisModifier::compile(ModifierOp* op) const
+{
+  op->opcode   = ModifierOp::kOpRotateAxis;
+  op->slot[0]  = m_xaxis;
+  op->slot[1]  = m_yaxis;
+  op->arg      = m_mirror;
+  op->param[0] = m_angle;
+  return true;
+}
+
 std::string
 RotateAxisModifier::str() const
 {
@@ -32,7 +32,8 @@ public:
   RotateAxisModifier(const std::string& xaxis, const std::string& yaxis, float angle, bool mirror);
 
   void init(ControllerMessageDescriptor& desc);
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  bool compile(ModifierOp* op) const;
   std::string str() const;
 
 private:
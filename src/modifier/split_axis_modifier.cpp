@@ -52,7 +52,7 @@ SplitAxisModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-SplitAxisModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+SplitAxisModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   float value = m_axis.get_float(msg);
   if (value < 0)
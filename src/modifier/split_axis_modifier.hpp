@@ -38,7 +38,7 @@ public:
   SplitAxisModifier(const std::string& axis, const std::string& out_lhs, const std::string& out_rhs);
 
   void init(ControllerMessageDescriptor& desc);
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
 
   std::string str() const;
 
@@ -23,10 +23,10 @@
 
 #include "controller_message.hpp"
 #include "helper.hpp"
+#include "modifier_program.hpp"
 
-namespace {
-
-void squarify_axis(float& x_inout, float& y_inout)
+void
+SquareAxisModifier::squarify(float& x_inout, float& y_inout)
 {
   if (x_inout != 0 || y_inout != 0)
   {
@@ -46,8 +46,6 @@ void squarify_axis(float& x_inout, float& y_inout)
   }
 }
 
-} // namespace
-
 
 SquareAxisModifier*
 SquareAxisModifier::from_string(const std::vector<std::string>& args)
@@ -86,17 +84,28 @@ SquareAxisModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-SquareAxisModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+SquareAxisModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   float x = m_xaxis_in.get_float(msg);
   float y = m_yaxis_in.get_float(msg);
 
-  squarify_axis(x, y);
+  squarify(x, y);
 
   m_xaxis_out.set_float(msg, x);
   m_yaxis_out.set_float(msg, y);
 }
 
+bool
+SquareAxisModifier::compile(ModifierOp* op) const
+{
+  op->opcode  = ModifierOp::kOpSquareAxis;
+  op->slot[0] = m_xaxis_in.get_abs();
+  op->slot[1] = m_yaxis_in.get_abs();
+  op->slot[2] = m_xaxis_out.get_abs();
+  op->slot[3] = m_yaxis_out.get_abs();
+  return true;
+}
+
 std::string
 SquareAxisModifier::str() const
 {
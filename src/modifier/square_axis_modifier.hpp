@@ -29,12 +29,16 @@ class SquareAxisModifier : public Modifier
 public:
   static SquareAxisModifier* from_string(const std::vector<std::string>& args);
 
+  /** Maps the circular stick range in [-1, 1] onto a square */
+  static void squarify(float& x_inout, float& y_inout);
+
 public:
   SquareAxisModifier(const std::string& x_axis_in,  const std::string& y_axis_in,
                      const std::string& x_axis_out, const std::string& y_axis_out);
 
   void init(ControllerMessageDescriptor& desc);
-  void update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  void update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc);
+  bool compile(ModifierOp* op) const;
 
   std::string str() const;
 
@@ -62,7 +62,7 @@ StatisticModifier::print_stats()
 }
 
 void
-StatisticModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+StatisticModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   for(size_t btn = 0; btn < m_press_count.size(); ++btn)
   {
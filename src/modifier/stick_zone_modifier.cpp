@@ -23,6 +23,7 @@
 #include <sstream>
 #include <stdexcept>
 
+#include "modifier_program.hpp"
 #include "xboxmsg.hpp"
 #include "raise_exception.hpp"
 
@@ -62,7 +63,7 @@ StickZoneModifier::init(ControllerMessageDescriptor& desc)
 }
 
 void
-StickZoneModifier::update(int msec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
+StickZoneModifier::update(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc)
 {
   float x = m_x_axis.get_float(msg);
   float y = m_y_axis.get_float(msg);
@@ -83,6 +84,18 @@ StickZoneModifier::update(int msec_delta, ControllerMessage& msg, const Controll
   }
 }
 
+bool
+StickZoneModifier::compile(ModifierOp* op) const
+{
+  op->opcode   = ModifierOp::kOpStickZone;
+  op->slot[0]  = m_x_axis.get_abs();
+  op->slot[1]  = m_y_axis.get_abs();
+  op->slot[2]  = m_button.get_key();
+  op->param[0] = m_range_start;
+  op->param[1] = m_range_end;
+  return true;
+}
+
 std::string
 StickZoneModifier::str() const
 {
@@ -0,0 +1,170 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "modifier_program.hpp"
+
+#include <math.h>
+
+#include "modifier/dpad_rotation_modifier.hpp"
+#include "modifier/square_axis_modifier.hpp"
+
+ModifierOp::ModifierOp() :
+  opcode(kOpNop),
+  slot(),
+  arg(0),
+  param(),
+  modifier(0)
+{
+}
+
+ModifierProgram::ModifierProgram() :
+  m_ops()
+{
+}
+
+void
+ModifierProgram::compile(const std::vector<ModifierPtr>& modifier)
+{
+  m_ops.clear();
+  m_ops.reserve(modifier.size());
+
+  for(std::vector<ModifierPtr>::const_iterator i = modifier.begin(); i != modifier.end(); ++i)
+  {
+    ModifierOp op;
+    if (!(*i)->compile(&op))
+    {
+      op = ModifierOp();
+      op.opcode   = ModifierOp::kOpVirtual;
+      op.modifier = i->get();
+    }
+
+    if (op.opcode != ModifierOp::kOpNop)
+    {
+      m_ops.push_back(op);
+    }
+  }
+}
+
+int
+ModifierProgram::get_inline_count() const
+{
+  int count = 0;
+  for(std::vector<ModifierOp>::const_iterator op = m_ops.begin(); op != m_ops.end(); ++op)
+  {
+    if (op->opcode != ModifierOp::kOpVirtual)
+    {
+      count += 1;
+    }
+  }
+  return count;
+}
+
+void
+ModifierProgram::run(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc) const
+{
+  for(std::vector<ModifierOp>::const_iterator op = m_ops.begin(); op != m_ops.end(); ++op)
+  {
+    switch(op->opcode)
+    {
+      case ModifierOp::kOpSquareAxis:
+        {
+          float x = msg.get_abs_float(op->slot[0]);
+          float y = msg.get_abs_float(op->slot[1]);
+          SquareAxisModifier::squarify(x, y);
+          msg.set_abs_float(op->slot[2], x);
+          msg.set_abs_float(op->slot[3], y);
+        }
+        break;
+
+      case ModifierOp::kOpFourWayRestrictor:
+        {
+          const float x = msg.get_abs_float(op->slot[0]);
+          const float y = msg.get_abs_float(op->slot[1]);
+          if (fabsf(x) > fabsf(y))
+          {
+            msg.set_abs_float(op->slot[2], x);
+            msg.set_abs_float(op->slot[3], 0);
+          }
+          else
+          {
+            msg.set_abs_float(op->slot[2], 0);
+            msg.set_abs_float(op->slot[3], y);
+          }
+        }
+        break;
+
+      case ModifierOp::kOpRotateAxis:
+        {
+          float x = msg.get_abs_float(op->slot[0]);
+          float y = msg.get_abs_float(op->slot[1]);
+
+          if (op->arg)
+          {
+            x = -x;
+          }
+
+          const float length = sqrtf(x*x + y*y);
+          const float angle  = atan2f(y, x) + op->param[0];
+
+          msg.set_abs_float(op->slot[0], cosf(angle) * length);
+          msg.set_abs_float(op->slot[1], sinf(angle) * length);
+        }
+        break;
+
+      case ModifierOp::kOpStickZone:
+        {
+          const float x = msg.get_abs_float(op->slot[0]);
+          const float y = msg.get_abs_float(op->slot[1]);
+          float r = sqrtf(x*x + y*y);
+          if (r > 1.0f)
+          {
+            r = 1.0f;
+          }
+          msg.set_key(op->slot[2], op->param[0] <= r && r <= op->param[1]);
+        }
+        break;
+
+      case ModifierOp::kOpDpadRotation:
+        {
+          bool up    = msg.get_key(op->slot[0]);
+          bool down  = msg.get_key(op->slot[1]);
+          bool left  = msg.get_key(op->slot[2]);
+          bool right = msg.get_key(op->slot[3]);
+
+          if (DpadRotationModifier::rotate(op->arg, up, down, left, right))
+          {
+            msg.set_key(op->slot[4], up);
+            msg.set_key(op->slot[5], down);
+            msg.set_key(op->slot[6], left);
+            msg.set_key(op->slot[7], right);
+          }
+        }
+        break;
+
+      case ModifierOp::kOpVirtual:
+        op->modifier->update(usec_delta, msg, desc);
+        break;
+
+      case ModifierOp::kOpNop:
+        break;
+    }
+  }
+}
+
+/* EOF */
@@ -0,0 +1,85 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_MODIFIER_PROGRAM_HPP
+#define HEADER_XBOXDRV_MODIFIER_PROGRAM_HPP
+
+#include <vector>
+
+#include "modifier.hpp"
+
+/** A single step of a ModifierProgram, filled in by
+    Modifier::compile() */
+struct ModifierOp
+{
+  enum OpCode {
+    kOpNop,
+    kOpVirtual,
+    kOpSquareAxis,
+    kOpFourWayRestrictor,
+    kOpRotateAxis,
+    kOpStickZone,
+    kOpDpadRotation
+  };
+
+  ModifierOp();
+
+  OpCode opcode;
+
+  /** resolved abs and key slots, their meaning depends on the
+      opcode, inputs come before outputs */
+  int slot[8];
+
+  int   arg;
+  float param[2];
+
+  /** the modifier to call for kOpVirtual */
+  Modifier* modifier;
+};
+
+/** The modifier chain of a ControllerConfig flattened into a list of
+    ModifierOps. Modifiers that can describe themselves as an op run
+    inline in run(), everything else, e.g. modifiers with time
+    dependent state, goes through the regular virtual update(). */
+class ModifierProgram
+{
+private:
+  std::vector<ModifierOp> m_ops;
+
+public:
+  ModifierProgram();
+
+  /** Compiles \a modifier, they have to be initialized already. The
+      program refers to them, so they have to outlive it. */
+  void compile(const std::vector<ModifierPtr>& modifier);
+
+  void run(int usec_delta, ControllerMessage& msg, const ControllerMessageDescriptor& desc) const;
+
+  /** number of ops that are run inline */
+  int get_inline_count() const;
+  int size() const { return static_cast<int>(m_ops.size()); }
+
+private:
+  ModifierProgram(const ModifierProgram&);
+  ModifierProgram& operator=(const ModifierProgram&);
+};
+
+#endif
+
+/* EOF */
@@ -113,6 +113,14 @@ Options::Options() :
   uinput_device_names(),
   uinput_device_usbids(),
   usb_debug(false),
+  usb_read_queue(2),
+  usb_thread(false),
+  usb_thread_priority(kPriorityNormal),
+  usb_hotplug(false),
+  usb_trace(),
+  replay_file(),
+  replay_fast(false),
+  generic_usb_layout(),
   m_generic_usb_specs()
 {
   // create the entry if not already available
@@ -184,6 +192,23 @@ Options::set_priority(const std::string& value)
   }
 }
 
+void
+Options::set_usb_thread_priority(const std::string& value)
+{
+  if (value == "realtime")
+  {
+    usb_thread_priority = kPriorityRealtime;
+  }
+  else if (value == "normal")
+  {
+    usb_thread_priority = kPriorityNormal;
+  }
+  else
+  {
+    raise_exception(std::runtime_error, "unknown priority value: '" << value << "'");
+  }
+}
+
 void
 Options::set_ui_clear()
 {
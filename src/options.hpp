@@ -26,6 +26,7 @@
 
 #include "controller_options.hpp"
 #include "controller_slot_options.hpp"
+#include "report_parser.hpp"
 #include "uinput_options.hpp"
 #include "xpad_device.hpp"
 
@@ -135,6 +136,17 @@ public:
   std::map<uint32_t, struct input_id> uinput_device_usbids;
 
   bool usb_debug;
+  int  usb_read_queue;
+  bool usb_thread;
+  Priority usb_thread_priority;
+  bool usb_hotplug;
+  std::string usb_trace;
+  std::string replay_file;
+  bool replay_fast;
+
+  /** layout of the reports of a generic-usb device, empty if the
+      reports should just be dumped */
+  std::vector<ReportField> generic_usb_layout;
 
   struct GenericUSBSpec
   {
@@ -185,6 +197,7 @@ public:
   const ControllerOptions& get_controller_options() const;
 
   void set_priority(const std::string& value);
+  void set_usb_thread_priority(const std::string& value);
 
   void set_ui_clear();
 
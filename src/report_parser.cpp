@@ -0,0 +1,393 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "report_parser.hpp"
+
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
+#include <stdexcept>
+
+#include "controller_message.hpp"
+#include "controller_message_descriptor.hpp"
+#include "raise_exception.hpp"
+
+namespace {
+
+/** Little endian bitfield extraction for fields that are not byte
+    aligned or of an odd size */
+inline uint32_t extract_bits(const uint8_t* p, int nbytes, int shift, uint32_t mask)
+{
+  uint64_t raw = 0;
+  for(int i = 0; i < nbytes; ++i)
+  {
+    raw |= static_cast<uint64_t>(p[i]) << (8 * i);
+  }
+  return static_cast<uint32_t>(raw >> shift) & mask;
+}
+
+int parse_int(const std::string& str)
+{
+  try
+  {
+    return boost::lexical_cast<int>(str);
+  }
+  catch(const boost::bad_lexical_cast&)
+  {
+    raise_exception(std::runtime_error, "not a number: '" << str << "'");
+  }
+}
+
+} // namespace
+
+ReportField::ReportField() :
+  name(),
+  kind(kKey),
+  byte(0),
+  bit(0),
+  width(1),
+  is_signed(false),
+  big_endian(false),
+  rescale(false),
+  out_min(0),
+  out_max(1)
+{
+}
+
+ReportField
+ReportField::from_string(const std::string& name, const std::string& spec)
+{
+  ReportField field;
+  field.name = name;
+
+  std::vector<std::string> tokens;
+  std::string::size_type start = 0;
+  for(;;)
+  {
+    std::string::size_type p = spec.find(':', start);
+    tokens.push_back(spec.substr(start, p == std::string::npos ? std::string::npos : p - start));
+    if (p == std::string::npos) break;
+    start = p + 1;
+  }
+
+  if (tokens.size() != 1 && tokens.size() != 2 && tokens.size() != 4)
+  {
+    raise_exception(std::runtime_error, "couldn't parse report field: " << name << "=" << spec);
+  }
+
+  // BYTE[.BIT]
+  std::string::size_type dot = tokens[0].find('.');
+  if (dot == std::string::npos)
+  {
+    field.byte = parse_int(tokens[0]);
+  }
+  else
+  {
+    field.byte = parse_int(tokens[0].substr(0, dot));
+    field.bit  = parse_int(tokens[0].substr(dot + 1));
+  }
+
+  if (field.byte < 0 || field.bit < 0 || field.bit > 7)
+  {
+    raise_exception(std::runtime_error, "invalid offset in report field: " << name << "=" << spec);
+  }
+
+  if (tokens.size() == 1)
+  {
+    field.kind  = kKey;
+    field.width = 1;
+  }
+  else if (tokens[1] == "hat")
+  {
+    field.kind  = kHat;
+    field.width = 4;
+    if (field.bit > 4)
+    {
+      raise_exception(std::runtime_error, "hat crosses a byte boundary: " << name << "=" << spec);
+    }
+  }
+  else
+  {
+    // s<bits>[le|be] or u<bits>[le|be]
+    std::string type = tokens[1];
+    field.kind = kAbs;
+
+    if (type.size() > 2 && (type.compare(type.size() - 2, 2, "le") == 0 ||
+                            type.compare(type.size() - 2, 2, "be") == 0))
+    {
+      field.big_endian = (type.compare(type.size() - 2, 2, "be") == 0);
+      type.erase(type.size() - 2);
+    }
+
+    if (type.size() < 2 || (type[0] != 's' && type[0] != 'u'))
+    {
+      raise_exception(std::runtime_error, "unknown type '" << tokens[1] << "' in report field: " << name);
+    }
+
+    field.is_signed = (type[0] == 's');
+    field.width = parse_int(type.substr(1));
+
+    // unsigned values must fit into an int
+    if (field.width < 1 || field.width > (field.is_signed ? 32 : 31))
+    {
+      raise_exception(std::runtime_error, "unsupported width in report field: " << name << "=" << spec);
+    }
+
+    if (field.big_endian && (field.bit != 0 || (field.width != 16 && field.width != 32)))
+    {
+      raise_exception(std::runtime_error, "big endian fields must be byte aligned 16 or 32 bit values: "
+                      << name << "=" << spec);
+    }
+  }
+
+  if (tokens.size() == 4)
+  {
+    if (field.kind != kAbs)
+    {
+      raise_exception(std::runtime_error, "only axis fields can be rescaled: " << name << "=" << spec);
+    }
+
+    field.rescale = true;
+    field.out_min = parse_int(tokens[2]);
+    field.out_max = parse_int(tokens[3]);
+  }
+  else
+  {
+    field.out_min = field.raw_min();
+    field.out_max = field.raw_max();
+  }
+
+  return field;
+}
+
+int
+ReportField::raw_min() const
+{
+  if (is_signed)
+  {
+    return static_cast<int>(-(static_cast<int64_t>(1) << (width - 1)));
+  }
+  else
+  {
+    return 0;
+  }
+}
+
+int
+ReportField::raw_max() const
+{
+  if (is_signed)
+  {
+    return static_cast<int>((static_cast<int64_t>(1) << (width - 1)) - 1);
+  }
+  else
+  {
+    return static_cast<int>((static_cast<int64_t>(1) << width) - 1);
+  }
+}
+
+ReportParser::ReportParser(const std::vector<ReportField>& layout, ControllerMessageDescriptor& desc) :
+  m_program(),
+  m_min_length(0)
+{
+  for(std::vector<ReportField>::const_iterator i = layout.begin(); i != layout.end(); ++i)
+  {
+    compile(*i, desc);
+  }
+}
+
+void
+ReportParser::compile(const ReportField& field, ControllerMessageDescriptor& desc)
+{
+  Op op;
+  op.offset  = field.byte;
+  op.shift   = field.bit;
+  op.nbytes  = (field.bit + field.width + 7) / 8;
+  op.mask    = (field.width == 32) ? 0xffffffffu : ((1u << field.width) - 1);
+  op.sign    = field.is_signed ? (1u << (field.width - 1)) : 0;
+  op.slot    = -1;
+  op.rescale = field.rescale;
+  op.raw_min = field.raw_min();
+  op.raw_max = field.raw_max();
+  op.out_min = field.out_min;
+  op.out_max = field.out_max;
+  op.min     = std::min(field.out_min, field.out_max);
+  op.max     = std::max(field.out_min, field.out_max);
+
+  if (field.width > 32 || op.nbytes > 5)
+  {
+    raise_exception(std::runtime_error, "report field too wide: " << field.name);
+  }
+  std::fill(op.hat, op.hat + 4, -1);
+
+  switch(field.kind)
+  {
+    case ReportField::kKey:
+      op.code = kOpBit;
+      op.slot = desc.key().getput(KeyName(field.name));
+      break;
+
+    case ReportField::kHat:
+      op.code = kOpHat;
+      op.hat[0] = desc.key().getput(KeyName(field.name + "_up"));
+      op.hat[1] = desc.key().getput(KeyName(field.name + "_down"));
+      op.hat[2] = desc.key().getput(KeyName(field.name + "_left"));
+      op.hat[3] = desc.key().getput(KeyName(field.name + "_right"));
+      break;
+
+    case ReportField::kHatAxes:
+      op.code = kOpHatAxes;
+      op.hat[0] = desc.abs().getput(AbsName(field.name + "X"));
+      op.hat[1] = desc.abs().getput(AbsName(field.name + "Y"));
+      break;
+
+    case ReportField::kAbs:
+      op.slot = desc.abs().getput(AbsName(field.name));
+
+      // byte aligned fields of the common sizes get their own opcode,
+      // everything else goes through the generic bit extractor
+      if (field.bit == 0 && field.width == 8)
+      {
+        op.code = field.is_signed ? kOpS8 : kOpU8;
+      }
+      else if (field.bit == 0 && field.width == 16)
+      {
+        if (field.big_endian)
+        {
+          op.code = field.is_signed ? kOpS16BE : kOpU16BE;
+        }
+        else
+        {
+          op.code = field.is_signed ? kOpS16LE : kOpU16LE;
+        }
+      }
+      else if (field.big_endian)
+      {
+        op.code = kOpBits32BE;
+      }
+      else
+      {
+        op.code = kOpBitsLE;
+      }
+      break;
+  }
+
+  m_min_length = std::max(m_min_length, field.byte + op.nbytes);
+  m_program.push_back(op);
+}
+
+bool
+ReportParser::parse(const uint8_t* data, int len, ControllerMessage* msg_out) const
+{
+  if (len < m_min_length)
+  {
+    return false;
+  }
+
+  // 0-7 clockwise from up, anything else is centered
+  static const uint8_t hat_bits[8] = {
+    0x1, 0x9, 0x8, 0xa, 0x2, 0x6, 0x4, 0x5
+  };
+
+  msg_out->clear();
+
+  for(std::vector<Op>::const_iterator op = m_program.begin(); op != m_program.end(); ++op)
+  {
+    const uint8_t* p = data + op->offset;
+    int value = 0;
+
+    switch(op->code)
+    {
+      case kOpBit:
+        msg_out->set_key(op->slot, (*p >> op->shift) & 1);
+        continue;
+
+      case kOpHat:
+      case kOpHatAxes:
+        {
+          uint32_t pos = extract_bits(p, op->nbytes, op->shift, op->mask) - static_cast<uint32_t>(op->out_min);
+          uint8_t bits = (pos < 8) ? hat_bits[pos] : 0;
+          if (op->code == kOpHat)
+          {
+            msg_out->set_key(op->hat[0], bits & 0x1);
+            msg_out->set_key(op->hat[1], bits & 0x2);
+            msg_out->set_key(op->hat[2], bits & 0x4);
+            msg_out->set_key(op->hat[3], bits & 0x8);
+          }
+          else
+          {
+            msg_out->set_abs(op->hat[0], ((bits >> 3) & 1) - ((bits >> 2) & 1), -1, 1);
+            msg_out->set_abs(op->hat[1], ((bits >> 1) & 1) - ((bits >> 0) & 1), -1, 1);
+          }
+        }
+        continue;
+
+      case kOpU8:
+        value = p[0];
+        break;
+
+      case kOpS8:
+        value = static_cast<int8_t>(p[0]);
+        break;
+
+      case kOpU16LE:
+        value = p[0] | (p[1] << 8);
+        break;
+
+      case kOpS16LE:
+        value = static_cast<int16_t>(p[0] | (p[1] << 8));
+        break;
+
+      case kOpU16BE:
+        value = (p[0] << 8) | p[1];
+        break;
+
+      case kOpS16BE:
+        value = static_cast<int16_t>((p[0] << 8) | p[1]);
+        break;
+
+      case kOpBits32BE:
+        value = static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 24) |
+                                     (static_cast<uint32_t>(p[1]) << 16) |
+                                     (static_cast<uint32_t>(p[2]) <<  8) |
+                                     (static_cast<uint32_t>(p[3]) <<  0));
+        break;
+
+      case kOpBitsLE:
+        {
+          uint32_t bits = extract_bits(p, op->nbytes, op->shift, op->mask);
+          value = static_cast<int32_t>((bits ^ op->sign) - op->sign);
+        }
+        break;
+    }
+
+    if (op->rescale)
+    {
+      value = static_cast<int>(op->out_min +
+                               (static_cast<int64_t>(value) - op->raw_min) *
+                               (static_cast<int64_t>(op->out_max) - op->out_min) /
+                               (static_cast<int64_t>(op->raw_max) - op->raw_min));
+    }
+
+    msg_out->set_abs(op->slot, value, op->min, op->max);
+  }
+
+  return true;
+}
+
+/* EOF */
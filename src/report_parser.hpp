@@ -0,0 +1,132 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_REPORT_PARSER_HPP
+#define HEADER_XBOXDRV_REPORT_PARSER_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class ControllerMessage;
+class ControllerMessageDescriptor;
+
+/** Description of a single field in a USB report */
+struct ReportField
+{
+  enum Kind { kKey, kAbs, kHat, kHatAxes };
+
+  /** Parse a field from NAME and a spec of the form
+      BYTE[.BIT][:TYPE[:MIN:MAX]], where TYPE is s<bits> or u<bits>
+      optionally followed by le or be, or 'hat'. A field without TYPE
+      is a single bit mapped to the key NAME, typed fields are mapped
+      to the axis NAME and rescaled to MIN:MAX when given. A hat is
+      four bits in the usual 0-7 clockwise encoding and drives the
+      keys NAME_up, NAME_down, NAME_left and NAME_right.
+
+      kHatAxes has no string form, it decodes a hat like kHat but
+      drives the axes NAMEX and NAMEY in [-1, 1] instead, the way the
+      kernel reports them. */
+  static ReportField from_string(const std::string& name, const std::string& spec);
+
+  ReportField();
+
+  std::string name;
+  Kind kind;
+  int  byte;
+  int  bit;
+  int  width;
+  bool is_signed;
+  bool big_endian;
+
+  /** output range, equal to the raw range when not rescaled, for
+      hats out_min is the value that means 'up' */
+  bool rescale;
+  int  out_min;
+  int  out_max;
+
+  int raw_min() const;
+  int raw_max() const;
+};
+
+/** Extracts ControllerMessage fields out of raw reports. The layout
+    is resolved against the ControllerMessageDescriptor once and
+    turned into a flat list of operations, parse() then only walks
+    that list. */
+class ReportParser
+{
+private:
+  enum OpCode {
+    kOpBit,
+    kOpU8,
+    kOpS8,
+    kOpU16LE,
+    kOpS16LE,
+    kOpU16BE,
+    kOpS16BE,
+    kOpBitsLE,
+    kOpBits32BE,
+    kOpHat,
+    kOpHatAxes
+  };
+
+  struct Op
+  {
+    OpCode   code;
+    int      offset;
+    int      shift;
+    int      nbytes; // bytes touched by the field
+    uint32_t mask;
+    uint32_t sign; // sign bit of kOpBitsLE fields, 0 if unsigned
+    int      slot;
+
+    // linear mapping of [raw_min, raw_max] onto [out_min, out_max]
+    bool rescale;
+    int  raw_min;
+    int  raw_max;
+    int  out_min;
+    int  out_max;
+
+    // range reported in the ControllerMessage
+    int  min;
+    int  max;
+
+    // kOpHat: up, down, left, right, kOpHatAxes: x, y
+    int hat[4];
+  };
+
+  std::vector<Op> m_program;
+  int m_min_length;
+
+public:
+  ReportParser(const std::vector<ReportField>& layout, ControllerMessageDescriptor& desc);
+
+  /** Returns false when \a len is too short for the layout */
+  bool parse(const uint8_t* data, int len, ControllerMessage* msg_out) const;
+
+  /** Smallest report the layout can be applied to */
+  int get_min_length() const { return m_min_length; }
+
+private:
+  void compile(const ReportField& field, ControllerMessageDescriptor& desc);
+};
+
+#endif
+
+/* EOF */
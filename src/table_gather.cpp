@@ -0,0 +1,88 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "table_gather.hpp"
+
+// the AVX2 version is compiled for its own target and only called
+// after checking the CPU, so it doesn't depend on -mavx2
+#if (defined(__x86_64__) || defined(__i386__)) && \
+  (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#  define XBOXDRV_TABLE_GATHER_AVX2
+#  include <immintrin.h>
+#endif
+
+namespace {
+
+void table_gather_loop(const int* base, const int* offset, const int* raw, const int* min,
+                       int* out, int i, int count)
+{
+  for(; i < count; ++i)
+  {
+    out[i] = offset[i] < 0 ? raw[i] : base[offset[i] + raw[i] - min[i]];
+  }
+}
+
+#ifdef XBOXDRV_TABLE_GATHER_AVX2
+__attribute__((target("avx2")))
+void table_gather_avx2(const int* base, const int* offset, const int* raw, const int* min,
+                       int* out, int count)
+{
+  // all tables share one base, so each lane is a plain 32 bit index,
+  // lanes without a table are masked off and keep their raw value
+  const __m256i none = _mm256_set1_epi32(-1);
+  int i = 0;
+  for(; i + 8 <= count; i += 8)
+  {
+    __m256i off = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offset + i));
+    __m256i val = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw + i));
+    __m256i idx = _mm256_add_epi32(off, _mm256_sub_epi32(val, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(min + i))));
+    __m256i mask = _mm256_cmpgt_epi32(off, none);
+
+    __m256i res = _mm256_mask_i32gather_epi32(val, base, idx, mask, 4);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), res);
+  }
+
+  table_gather_loop(base, offset, raw, min, out, i, count);
+}
+
+bool has_avx2()
+{
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  return avx2;
+}
+#endif
+
+} // namespace
+
+void
+table_gather(const int* base, const int* offset, const int* raw, const int* min,
+             int* out, int count)
+{
+#ifdef XBOXDRV_TABLE_GATHER_AVX2
+  if (has_avx2())
+  {
+    table_gather_avx2(base, offset, raw, min, out, count);
+    return;
+  }
+#endif
+
+  table_gather_loop(base, offset, raw, min, out, 0, count);
+}
+
+/* EOF */
@@ -0,0 +1,35 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_TABLE_GATHER_HPP
+#define HEADER_XBOXDRV_TABLE_GATHER_HPP
+
+/** Look up \a count values in tables stored back to back at \a base:
+    out[i] is base[offset[i] + raw[i] - min[i]], or raw[i] unchanged
+    when offset[i] is negative. Used to run the baked stateless axis
+    filters of a whole message in one go.
+
+    Uses AVX2 gathers when the CPU has them, checked at runtime so the
+    build doesn't need -mavx2, and a plain loop otherwise. */
+void table_gather(const int* base, const int* offset, const int* raw, const int* min,
+                  int* out, int count);
+
+#endif
+
+/* EOF */
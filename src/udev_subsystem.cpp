@@ -19,6 +19,8 @@
 #include "udev_subsystem.hpp"
 
 #include <stdexcept>
+#include <sys/types.h>
+#include <sys/sysmacros.h>
 
 #include "raise_exception.hpp"
 
@@ -155,6 +157,15 @@ UdevSubsystem::on_udev_data(GIOChannel* channel, GIOCondition condition)
   return true;
 }
 
+udev_device*
+UdevSubsystem::get_usb_device(int busnum, int devnum)
+{
+  // usb_device nodes use major 189, with the minor derived from bus
+  // and device number, see drivers/usb/core/file.c in the kernel
+  dev_t devt = makedev(189, ((busnum - 1) << 7) + (devnum - 1));
+  return udev_device_new_from_devnum(m_udev, 'c', devt);
+}
+
 void
 UdevSubsystem::print_info(udev_device* device)
 {
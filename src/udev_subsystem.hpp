@@ -41,6 +41,11 @@ public:
   void enumerate_udev_devices();
   void print_info(udev_device* device);
 
+  /** Returns the udev_device for the USB device at \a busnum:\a
+      devnum without enumerating, the caller must unref it, NULL if
+      the device isn't known to udev */
+  udev_device* get_usb_device(int busnum, int devnum);
+
 private:
   bool on_udev_data(GIOChannel* channel, GIOCondition condition);
 
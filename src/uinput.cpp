@@ -18,6 +18,7 @@
 
 #include "uinput.hpp"
 
+#include <boost/bind.hpp>
 #include <boost/tokenizer.hpp>
 #include <iostream>
 #include <math.h>
@@ -111,26 +112,70 @@ UInput::UInput(bool extra_events) :
   m_rel_repeat_lst(),
   m_extra_events(extra_events),
   m_timeout_id(),
-  m_timer(g_timer_new())
+  m_last_time(g_get_monotonic_time()),
+  m_usec_rest(0)
 {
-  // FIXME: hardcoded timeout is kind of evil
-  // FIXME: would be nicer if UInput didn't depend on glib
-  m_timeout_id = g_timeout_add(10, &UInput::on_timeout_wrap, this);
 }
 
 UInput::~UInput()
 {
-  g_source_remove(m_timeout_id);
-  g_timer_destroy(m_timer);
+  if (m_timeout_id)
+  {
+    g_source_remove(m_timeout_id);
+  }
+}
+
+void
+UInput::schedule_update()
+{
+  if (!m_timeout_id)
+  {
+    // nothing time dependent happened while the timer was off, so
+    // don't hand the idle time to the new work
+    m_last_time = g_get_monotonic_time();
+
+    // FIXME: hardcoded timeout is kind of evil
+    // FIXME: would be nicer if UInput didn't depend on glib
+    m_timeout_id = g_timeout_add(10, &UInput::on_timeout_wrap, this);
+  }
+}
+
+bool
+UInput::needs_update() const
+{
+  if (!m_rel_repeat_lst.empty())
+  {
+    return true;
+  }
+
+  for(UInputDevs::const_iterator i = m_uinput_devs.begin(); i != m_uinput_devs.end(); ++i)
+  {
+    if (i->second->needs_update())
+    {
+      return true;
+    }
+  }
+
+  return false;
 }
 
 bool
 UInput::on_timeout()
 {
-  int msec_delta = static_cast<int>(g_timer_elapsed(m_timer, NULL) * 1000.0f);
-  g_timer_reset(m_timer);
-  update(msec_delta);
-  return true;  // do not remove the callback
+  const gint64 now = g_get_monotonic_time();
+  const int usec_delta = static_cast<int>(now - m_last_time);
+  m_last_time = now;
+  update(usec_delta);
+
+  if (needs_update())
+  {
+    return true;
+  }
+  else
+  {
+    m_timeout_id = 0;
+    return false;
+  }
 }
 
 struct input_id
@@ -315,6 +360,7 @@ UInput::create_uinput_device(uint32_t device_id)
 
     std::string dev_name = get_device_name(device_id);
     boost::shared_ptr<LinuxUinput> dev(new LinuxUinput(device_type, dev_name, get_device_usbid(device_id)));
+    dev->set_update_callback(boost::bind(&UInput::schedule_update, this));
     m_uinput_devs.insert(std::pair<int, boost::shared_ptr<LinuxUinput> >(device_id, dev));
 
     log_debug("created uinput device: " << device_id << " - '" << dev_name << "'");
@@ -441,15 +487,15 @@ UInput::send(uint32_t device_id, int ev_type, int ev_code, int value)
 }
 
 void
-UInput::update(int msec_delta)
+UInput::update(int usec_delta)
 {
   for(std::map<UIEvent, RelRepeat>::iterator i = m_rel_repeat_lst.begin(); i != m_rel_repeat_lst.end(); ++i)
   {
-    i->second.time_count += msec_delta;
+    i->second.time_count += usec_delta;
 
     // FIXME: shouldn't send out events multiple times, but accumulate
     // them instead and send out only once
-    while (i->second.time_count >= i->second.repeat_interval)
+    while (i->second.time_count >= i->second.repeat_interval * 1000)
     {
       // value can be float, but be can only send out int, so keep
       // track of the rest we don't send
@@ -458,10 +504,16 @@ UInput::update(int msec_delta)
       i->second.rest += i->second.value - truncf(i->second.value);
 
       get_uinput(i->second.code.get_device_id())->send(EV_REL, static_cast<uint16_t>(i->second.code.code), i_value);
-      i->second.time_count -= i->second.repeat_interval;
+      i->second.time_count -= i->second.repeat_interval * 1000;
     }
   }
 
+  // force feedback effects are timed in msec, carry the rest over so
+  // that no time gets lost
+  m_usec_rest += usec_delta;
+  const int msec_delta = m_usec_rest / 1000;
+  m_usec_rest -= msec_delta * 1000;
+
   for(UInputDevs::iterator i = m_uinput_devs.begin(); i != m_uinput_devs.end(); ++i)
   {
     i->second->update(msec_delta);
@@ -504,6 +556,7 @@ UInput::send_rel_repetitive(const UIEvent& code, float value, int repeat_interva
       rel_rep.time_count = 0;
       rel_rep.repeat_interval = repeat_interval;
       m_rel_repeat_lst.insert(std::pair<UIEvent, RelRepeat>(code, rel_rep));
+      schedule_update();
     
       // Send the event once
       get_uinput(code.get_device_id())->send(EV_REL, static_cast<uint16_t>(code.code), static_cast<int32_t>(value));
@@ -70,16 +70,18 @@ private:
     UIEvent code;
     float value;
     float rest;
-    int time_count;
-    int repeat_interval;
+    int time_count; /// usec
+    int repeat_interval; /// msec
   };
 
   std::map<UIEvent, RelRepeat> m_rel_repeat_lst;
 
   bool m_extra_events;
 
+  /** only armed while there is rel repeat or force feedback work */
   guint m_timeout_id;
-  GTimer* m_timer;
+  gint64 m_last_time; /// monotonic time in usec of the last update
+  int m_usec_rest; /// time not yet passed on to the devices
 
 public:
   UInput(bool extra_events);
@@ -119,7 +121,13 @@ public:
   /** @} */
 
 private:
-  void update(int msec_delta);
+  void update(int usec_delta);
+
+  /** true while update() has work to do */
+  bool needs_update() const;
+
+  /** arms the timer that calls update(), if it isn't already */
+  void schedule_update();
 
   /** create a LinuxUinput with the given device_id, if some already
       exist return a pointer to it */
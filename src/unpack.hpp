@@ -19,20 +19,26 @@
 #ifndef HEADER_XBOXDRV_ENDIAN_HPP
 #define HEADER_XBOXDRV_ENDIAN_HPP
 
+#include <endian.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "helper.hpp"
 
 namespace unpack {
 
+/** Byte order of the host, known at compile time so that the
+    readers below compile down to a plain load (plus a bswap where
+    needed) */
+#if __BYTE_ORDER == __BIG_ENDIAN
+const bool kHostBigEndian = true;
+#else
+const bool kHostBigEndian = false;
+#endif
+
 inline bool is_big_endian()
 {
-  union {
-    uint32_t i;
-    char c[4];
-  } bint = {0x01020304};
-
-  return bint.c[0] == 1;
+  return kHostBigEndian;
 }
 
 inline uint16_t swap16(uint16_t v)
@@ -45,60 +51,96 @@ inline uint32_t swap32(uint32_t v)
   return (v<<24) | ((v<<8) & 0x00ff0000) | ((v>>8) & 0x0000ff00) | (v>>24);
 }
 
-
-inline int16_t int16le(const uint8_t* data)
+/** Unaligned load, memcpy() keeps this well defined and compilers
+    turn it into a single move */
+template<typename T>
+inline T load(const uint8_t* data)
 {
-  if (is_big_endian()) return swap16(*reinterpret_cast<const int16_t*>(data));
-  else                 return *reinterpret_cast<const int16_t*>(data);
+  T v;
+  memcpy(&v, data, sizeof(T));
+  return v;
 }
 
+/** Converts from a byte order to host order, \a Swap is true when
+    the byte order differs from the host */
+template<bool Swap>
+struct ByteOrder
+{
+  static uint16_t convert(uint16_t v) { return v; }
+  static uint32_t convert(uint32_t v) { return v; }
+};
+
+template<>
+struct ByteOrder<true>
+{
+  static uint16_t convert(uint16_t v) { return swap16(v); }
+  static uint32_t convert(uint32_t v) { return swap32(v); }
+};
+
+typedef ByteOrder<kHostBigEndian>  LittleEndian;
+typedef ByteOrder<!kHostBigEndian> BigEndian;
+
+
 inline uint16_t uint16le(const uint8_t* data)
 {
-  if (is_big_endian()) return swap16(*reinterpret_cast<const uint16_t*>(data));
-  else                 return *reinterpret_cast<const uint16_t*>(data);
+  return LittleEndian::convert(load<uint16_t>(data));
 }
 
-
-inline int32_t int32le(const uint8_t* data)
+inline int16_t int16le(const uint8_t* data)
 {
-  if (is_big_endian()) return swap32(*reinterpret_cast<const int32_t*>(data));
-  else                 return *reinterpret_cast<const int32_t*>(data);
+  return static_cast<int16_t>(uint16le(data));
 }
 
 inline uint32_t uint32le(const uint8_t* data)
 {
-  if (is_big_endian()) return swap32(*reinterpret_cast<const uint32_t*>(data));
-  else                 return *reinterpret_cast<const uint32_t*>(data);
+  return LittleEndian::convert(load<uint32_t>(data));
+}
+
+inline int32_t int32le(const uint8_t* data)
+{
+  return static_cast<int32_t>(uint32le(data));
 }
 
 
+inline uint16_t uint16be(const uint8_t* data)
+{
+  return BigEndian::convert(load<uint16_t>(data));
+}
 
 inline int16_t int16be(const uint8_t* data)
 {
-  if (!is_big_endian()) return swap16(*reinterpret_cast<const int16_t*>(data));
-  else                  return *reinterpret_cast<const int16_t*>(data);
+  return static_cast<int16_t>(uint16be(data));
 }
 
-inline uint16_t uint16be(const uint8_t* data)
+inline uint32_t uint32be(const uint8_t* data)
 {
-  if (!is_big_endian()) return swap16(*reinterpret_cast<const uint16_t*>(data));
-  else                  return *reinterpret_cast<const uint16_t*>(data);
+  return BigEndian::convert(load<uint32_t>(data));
 }
 
-
 inline int32_t int32be(const uint8_t* data)
 {
-  if (!is_big_endian()) return swap32(*reinterpret_cast<const int32_t*>(data));
-  else                  return *reinterpret_cast<const int32_t*>(data);
+  return static_cast<int32_t>(uint32be(data));
 }
 
-inline uint32_t uint32be(const uint8_t* data)
+
+/** Decode \a count consecutive little endian int16 values, e.g. all
+    stick axes of a report in one go. On little endian hosts this is
+    a single copy. */
+inline void int16le_array(const uint8_t* data, int16_t* out, int count)
 {
-  if (!is_big_endian()) return swap32(*reinterpret_cast<const uint32_t*>(data));
-  else                  return *reinterpret_cast<const uint32_t*>(data);
+  if (!kHostBigEndian)
+  {
+    memcpy(out, data, count * sizeof(int16_t));
+  }
+  else
+  {
+    for(int i = 0; i < count; ++i)
+    {
+      out[i] = int16le(data + 2*i);
+    }
+  }
 }
 
-
 inline bool bit(const uint8_t* data, int bit)
 {
   return (*data >> bit) & 1;
@@ -0,0 +1,111 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "usb_device_handle.hpp"
+
+#include <boost/format.hpp>
+#include <sstream>
+#include <stdexcept>
+
+#include "raise_exception.hpp"
+#include "usb_helper.hpp"
+
+USBDeviceHandle::USBDeviceHandle(libusb_device* dev) :
+  m_dev(dev),
+  m_handle(0),
+  m_interfaces(),
+  m_usbpath(),
+  m_usbid(),
+  m_name()
+{
+  int ret = libusb_open(dev, &m_handle);
+  if (ret != LIBUSB_SUCCESS)
+  {
+    raise_exception(std::runtime_error, "libusb_open() failed: " << usb_strerror(ret));
+  }
+  else
+  { 
+    // get usbpath, usbid and name
+    m_usbpath = (boost::format("%03d:%03d") 
+                 % static_cast<int>(libusb_get_bus_number(dev))
+                 % static_cast<int>(libusb_get_device_address(dev))).str();
+
+    libusb_device_descriptor desc;
+    ret = libusb_get_device_descriptor(dev, &desc);
+    if (ret == LIBUSB_SUCCESS)
+    {
+      m_usbid = (boost::format("%04x:%04x") 
+                 % static_cast<int>(desc.idVendor) 
+                 % static_cast<int>(desc.idProduct)).str();
+  
+      char buf[1024];
+      int len;
+      if (false)
+      { // FIXME: do we need the manufacturer name?
+        len = libusb_get_string_descriptor_ascii(m_handle, desc.iManufacturer,
+                                                 reinterpret_cast<unsigned char*>(buf), sizeof(buf));
+        if (len > 0)
+        {
+          m_name.append(buf, len);
+          m_name.append(" ");
+        }
+      }
+
+      len = libusb_get_string_descriptor_ascii(m_handle, desc.iProduct, 
+                                               reinterpret_cast<unsigned char*>(buf), sizeof(buf));
+      if (len > 0)
+      {
+        m_name.append(buf, len);
+      }
+    }
+  }
+}
+
+USBDeviceHandle::~USBDeviceHandle()
+{
+  // release all claimed interfaces
+  for(std::set<int>::iterator it = m_interfaces.begin(); it != m_interfaces.end(); ++it)
+  {
+    libusb_release_interface(m_handle, *it);
+  }
+
+  libusb_close(m_handle);
+}
+
+void
+USBDeviceHandle::claim_interface(int ifnum, bool try_detach)
+{
+  if (m_interfaces.find(ifnum) == m_interfaces.end())
+  {
+    int err = usb_claim_n_detach_interface(m_handle, ifnum, try_detach);
+    if (err != 0) 
+    {
+      std::ostringstream out;
+      out << " Error couldn't claim the USB interface: " << usb_strerror(err) << std::endl
+          << "Try to run 'rmmod xpad' and then xboxdrv again or start xboxdrv with the option --detach-kernel-driver.";
+      throw std::runtime_error(out.str());
+    }
+
+    // keep track of all claimed interfaces so they can be released in
+    // the destructor
+    m_interfaces.insert(ifnum);
+  }
+}
+
+/* EOF */
@@ -0,0 +1,67 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_USB_DEVICE_HANDLE_HPP
+#define HEADER_XBOXDRV_USB_DEVICE_HANDLE_HPP
+
+#include <boost/shared_ptr.hpp>
+#include <libusb.h>
+#include <set>
+#include <string>
+
+/** An opened USB device along with the interfaces claimed on it,
+    devices that expose multiple controllers, like the Xbox360
+    wireless receiver, share one USBDeviceHandle between all of them,
+    so the device is only opened and queried once */
+class USBDeviceHandle
+{
+private:
+  libusb_device* m_dev;
+  libusb_device_handle* m_handle;
+  std::set<int> m_interfaces;
+
+  std::string m_usbpath;
+  std::string m_usbid;
+  std::string m_name;
+
+public:
+  USBDeviceHandle(libusb_device* dev);
+  ~USBDeviceHandle();
+
+  libusb_device* get_device() const { return m_dev; }
+  libusb_device_handle* get_handle() const { return m_handle; }
+
+  std::string get_usbpath() const { return m_usbpath; }
+  std::string get_usbid() const { return m_usbid; }
+  std::string get_name() const { return m_name; }
+
+  /** Claims interface \a ifnum, interfaces that are already claimed
+      are left alone, all interfaces are released in the destructor */
+  void claim_interface(int ifnum, bool try_detach);
+
+private:
+  USBDeviceHandle(const USBDeviceHandle&);
+  USBDeviceHandle& operator=(const USBDeviceHandle&);
+};
+
+typedef boost::shared_ptr<USBDeviceHandle> USBDeviceHandlePtr;
+
+#endif
+
+/* EOF */
@@ -30,7 +30,8 @@ USBGSource::USBGSource() :
   m_source_funcs(),
   m_source(),
   m_source_id(),
-  m_pollfds()
+  m_pollfds(),
+  m_pollfd_index()
 {
   // create the source functions
   m_source_funcs.prepare  = &USBGSource::on_source_prepare;
@@ -69,7 +70,13 @@ USBGSource::~USBGSource()
   libusb_set_pollfd_notifiers(NULL, NULL, NULL, NULL);
   
   // get rid of the GSource created in the constructor
-  g_source_unref(reinterpret_cast<GSource*>(m_source));
+  g_source_destroy(&m_source->source);
+  g_source_unref(&m_source->source);
+
+  for(std::vector<GPollFD*>::iterator i = m_pollfds.begin(); i != m_pollfds.end(); ++i)
+  {
+    delete *i;
+  }
 }
 
 void
@@ -82,37 +89,56 @@ USBGSource::attach(GMainContext* context)
 void
 USBGSource::on_usb_pollfd_added(int fd, short events)
 {
-  GPollFD* gfd = new GPollFD;
+  assert(fd >= 0);
+
+  if (fd >= static_cast<int>(m_pollfd_index.size()))
+  {
+    m_pollfd_index.resize(fd + 1, -1);
+  }
 
-  gfd->fd = fd;
-  gfd->events  = events;
-  gfd->revents = 0;
+  if (m_pollfd_index[fd] != -1)
+  {
+    // libusb is reusing an fd it already told us about, just update the events
+    m_pollfds[m_pollfd_index[fd]]->events = events;
+  }
+  else
+  {
+    GPollFD* gfd = new GPollFD;
+
+    gfd->fd = fd;
+    gfd->events  = events;
+    gfd->revents = 0;
 
-  g_source_add_poll(&m_source->source, gfd);
+    g_source_add_poll(&m_source->source, gfd);
 
-  m_pollfds.push_back(gfd);
+    m_pollfd_index[fd] = static_cast<int>(m_pollfds.size());
+    m_pollfds.push_back(gfd);
+  }
 }
 
 void
 USBGSource::on_usb_pollfd_removed(int fd)
 {
-  // find the GPollFD that matched the given \a fd
-  std::list<GPollFD*>::iterator it = m_pollfds.end();
-  for(std::list<GPollFD*>::iterator i = m_pollfds.begin(); i != m_pollfds.end(); ++i)
+  if (fd < 0 || fd >= static_cast<int>(m_pollfd_index.size()) || m_pollfd_index[fd] == -1)
   {
-    if ((*i)->fd == fd)
-    {
-      it = i;
-      break;
-    }
+    // libusb can report fds that were never handed to us, e.g. when
+    // they were closed before the notifiers got registered
+    log_warn("unknown pollfd removed: " << fd);
   }
-  
-  assert(it != m_pollfds.end());
+  else
+  {
+    const int idx = m_pollfd_index[fd];
+    GPollFD* gfd = m_pollfds[idx];
+
+    g_source_remove_poll(&m_source->source, gfd);
+    delete gfd;
 
-  // FIXME: here is a bug
-  g_source_remove_poll(&m_source->source, *it);
-  delete *it;
-  m_pollfds.erase(it);
+    // move the last entry into the hole to keep m_pollfds packed
+    m_pollfds[idx] = m_pollfds.back();
+    m_pollfd_index[m_pollfds[idx]->fd] = idx;
+    m_pollfds.pop_back();
+    m_pollfd_index[fd] = -1;
+  }
 }
 
 gboolean
@@ -143,20 +169,10 @@ gboolean
 USBGSource::on_source_check(GSource* source)
 {
   USBGSource* usb_source = reinterpret_cast<GUSBSource*>(source)->usb_source;
-  //log_debug("Number of PollFD: " << usb_source->m_pollfds.size());
-  for(std::list<GPollFD*>::iterator i = usb_source->m_pollfds.begin(); i != usb_source->m_pollfds.end(); ++i)
+  const std::vector<GPollFD*>& pollfds = usb_source->m_pollfds;
+  for(std::vector<GPollFD*>::size_type i = 0; i < pollfds.size(); ++i)
   {
-    if (false)
-    {
-      log_debug("GSource GPollFD: " << (*i)->fd);
-      log_debug("REvents: G_IO_OUT: " << ((*i)->revents & G_IO_OUT));
-      log_debug("         G_IO_IN:  " << ((*i)->revents & G_IO_IN));
-      log_debug("         G_IO_PRI: " << ((*i)->revents & G_IO_PRI));
-      log_debug("         G_IO_HUP: " << ((*i)->revents & G_IO_HUP));
-      log_debug("         G_IO_ERR: " << ((*i)->revents & G_IO_ERR));
-    }
-
-    if ((*i)->revents)
+    if (pollfds[i]->revents)
     {
       return TRUE;
     }
@@ -174,7 +190,14 @@ USBGSource::on_source_dispatch(GSource* source, GSourceFunc callback, gpointer u
 gboolean
 USBGSource::on_source()
 {
-  libusb_handle_events(NULL);
+  // the fds are already known to be ready, so only do a single
+  // non-blocking pass instead of waiting for further events
+  struct timeval tv = { 0, 0 };
+  int ret = libusb_handle_events_timeout_completed(NULL, &tv, NULL);
+  if (ret != 0)
+  {
+    log_error("libusb_handle_events_timeout_completed() failed: " << usb_strerror(ret));
+  }
   return TRUE;
 }
 
@@ -20,7 +20,7 @@
 #define HEADER_XBOXDRV_USB_GSOURCE_HPP
 
 #include <glib.h>
-#include <list>
+#include <vector>
 
 class USBGSource;
 
@@ -36,7 +36,12 @@ private:
   GSourceFuncs m_source_funcs;
   GUSBSource* m_source;
   gint m_source_id;
-  std::list<GPollFD*> m_pollfds;
+
+  /** densely packed for on_source_check() */
+  std::vector<GPollFD*> m_pollfds;
+
+  /** maps a fd to its position in m_pollfds, -1 if unused */
+  std::vector<int> m_pollfd_index;
 
 public:
   USBGSource();
@@ -0,0 +1,314 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "usb_hotplug.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "log.hpp"
+#include "raise_exception.hpp"
+#include "usb_helper.hpp"
+#include "xpad_device.hpp"
+
+namespace {
+
+class Lock
+{
+private:
+  pthread_mutex_t& m_mutex;
+
+public:
+  Lock(pthread_mutex_t& mutex) : m_mutex(mutex) { pthread_mutex_lock(&m_mutex); }
+  ~Lock() { pthread_mutex_unlock(&m_mutex); }
+
+private:
+  Lock(const Lock&);
+  Lock& operator=(const Lock&);
+};
+
+uint16_t make_path_key(uint8_t busnum, uint8_t devnum)
+{
+  return static_cast<uint16_t>((busnum << 8) | devnum);
+}
+
+uint32_t make_id_key(uint16_t vendor_id, uint16_t product_id)
+{
+  return (static_cast<uint32_t>(vendor_id) << 16) | product_id;
+}
+
+} // namespace
+
+bool
+USBHotplug::is_supported()
+{
+  return libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG);
+}
+
+USBHotplug::USBHotplug() :
+  m_callback_handle(),
+  m_mutex(),
+  m_by_path(),
+  m_by_id(),
+  m_devices(),
+  m_arrivals(),
+  m_idle_source(0),
+  m_device_cb()
+{
+  pthread_mutex_init(&m_mutex, NULL);
+
+  // LIBUSB_HOTPLUG_ENUMERATE reports the devices that are already
+  // present right away, so the index is complete once this returns
+  int ret = libusb_hotplug_register_callback(NULL,
+                                             static_cast<libusb_hotplug_event>(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED |
+                                                                               LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT),
+                                             LIBUSB_HOTPLUG_ENUMERATE,
+                                             LIBUSB_HOTPLUG_MATCH_ANY,
+                                             LIBUSB_HOTPLUG_MATCH_ANY,
+                                             LIBUSB_HOTPLUG_MATCH_ANY,
+                                             &USBHotplug::on_hotplug_wrap, this,
+                                             &m_callback_handle);
+  if (ret != LIBUSB_SUCCESS)
+  {
+    pthread_mutex_destroy(&m_mutex);
+    raise_exception(std::runtime_error, "libusb_hotplug_register_callback() failed: " << usb_strerror(ret));
+  }
+}
+
+USBHotplug::~USBHotplug()
+{
+  libusb_hotplug_deregister_callback(NULL, m_callback_handle);
+
+  if (m_idle_source)
+  {
+    g_source_remove(m_idle_source);
+  }
+
+  for(std::vector<libusb_device*>::iterator i = m_arrivals.begin(); i != m_arrivals.end(); ++i)
+  {
+    libusb_unref_device(*i);
+  }
+
+  for(PathIndex::iterator i = m_by_path.begin(); i != m_by_path.end(); ++i)
+  {
+    libusb_unref_device(i->second);
+  }
+
+  pthread_mutex_destroy(&m_mutex);
+}
+
+void
+USBHotplug::set_device_callback(const boost::function<void (libusb_device*)>& device_cb)
+{
+  Lock lock(m_mutex);
+
+  m_device_cb = device_cb;
+
+  if (m_device_cb)
+  {
+    // report the devices that are already known
+    for(PathIndex::iterator i = m_by_path.begin(); i != m_by_path.end(); ++i)
+    {
+      libusb_ref_device(i->second);
+      m_arrivals.push_back(i->second);
+    }
+
+    if (!m_arrivals.empty() && !m_idle_source)
+    {
+      m_idle_source = g_idle_add(&USBHotplug::on_idle_wrap, this);
+    }
+  }
+}
+
+libusb_device*
+USBHotplug::find_device_by_path(uint8_t busnum, uint8_t devnum)
+{
+  Lock lock(m_mutex);
+
+  PathIndex::iterator it = m_by_path.find(make_path_key(busnum, devnum));
+  if (it == m_by_path.end())
+  {
+    return 0;
+  }
+  else
+  {
+    return libusb_ref_device(it->second);
+  }
+}
+
+libusb_device*
+USBHotplug::find_device_by_id(int id, uint16_t vendor_id, uint16_t product_id)
+{
+  Lock lock(m_mutex);
+
+  IdIndex::iterator it = m_by_id.find(make_id_key(vendor_id, product_id));
+  if (it == m_by_id.end() || id < 0 || id >= static_cast<int>(it->second.size()))
+  {
+    return 0;
+  }
+  else
+  {
+    return libusb_ref_device(it->second[id]);
+  }
+}
+
+libusb_device*
+USBHotplug::find_xpad_device(int id, XPadDevice* type)
+{
+  Lock lock(m_mutex);
+
+  int id_count = 0;
+  for(DeviceList::iterator it = m_devices.begin(); it != m_devices.end(); ++it)
+  {
+    XPadDevice dev_type;
+    if (::find_xpad_device(static_cast<uint16_t>(it->second >> 16),
+                           static_cast<uint16_t>(it->second & 0xffff),
+                           &dev_type))
+    {
+      if (id_count == id)
+      {
+        *type = dev_type;
+        return libusb_ref_device(it->first);
+      }
+      else
+      {
+        id_count += 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
+void
+USBHotplug::add_device(libusb_device* dev)
+{
+  libusb_device_descriptor desc;
+  int ret = libusb_get_device_descriptor(dev, &desc);
+  if (ret != LIBUSB_SUCCESS)
+  {
+    log_warn("libusb_get_device_descriptor() failed: " << usb_strerror(ret));
+  }
+  else
+  {
+    const uint16_t path_key = make_path_key(libusb_get_bus_number(dev), libusb_get_device_address(dev));
+
+    PathIndex::iterator it = m_by_path.find(path_key);
+    if (it != m_by_path.end())
+    {
+      // the LEFT event for the previous device on this address got lost
+      remove_device(it->second);
+    }
+
+    const uint32_t id_key = make_id_key(desc.idVendor, desc.idProduct);
+
+    m_by_path[path_key] = libusb_ref_device(dev);
+    m_by_id[id_key].push_back(dev);
+    m_devices.push_back(std::make_pair(dev, id_key));
+
+    if (m_device_cb)
+    {
+      m_arrivals.push_back(libusb_ref_device(dev));
+      if (!m_idle_source)
+      {
+        m_idle_source = g_idle_add(&USBHotplug::on_idle_wrap, this);
+      }
+    }
+  }
+}
+
+void
+USBHotplug::remove_device(libusb_device* dev)
+{
+  PathIndex::iterator it = m_by_path.find(make_path_key(libusb_get_bus_number(dev), 
+                                                        libusb_get_device_address(dev)));
+  if (it != m_by_path.end() && it->second == dev)
+  {
+    libusb_device_descriptor desc;
+    if (libusb_get_device_descriptor(dev, &desc) == LIBUSB_SUCCESS)
+    {
+      IdIndex::iterator id_it = m_by_id.find(make_id_key(desc.idVendor, desc.idProduct));
+      if (id_it != m_by_id.end())
+      {
+        std::vector<libusb_device*>& lst = id_it->second;
+        lst.erase(std::remove(lst.begin(), lst.end(), dev), lst.end());
+        if (lst.empty())
+        {
+          m_by_id.erase(id_it);
+        }
+      }
+    }
+
+    for(DeviceList::iterator i = m_devices.begin(); i != m_devices.end(); ++i)
+    {
+      if (i->first == dev)
+      {
+        m_devices.erase(i);
+        break;
+      }
+    }
+
+    m_by_path.erase(it);
+    libusb_unref_device(dev);
+  }
+}
+
+void
+USBHotplug::on_hotplug(libusb_device* dev, libusb_hotplug_event event)
+{
+  Lock lock(m_mutex);
+
+  if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED)
+  {
+    add_device(dev);
+  }
+  else if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT)
+  {
+    remove_device(dev);
+  }
+}
+
+bool
+USBHotplug::on_idle()
+{
+  std::vector<libusb_device*> arrivals;
+  boost::function<void (libusb_device*)> device_cb;
+
+  {
+    Lock lock(m_mutex);
+    arrivals.swap(m_arrivals);
+    device_cb = m_device_cb;
+    m_idle_source = 0;
+  }
+
+  // the callback is run without the lock held, as it will likely
+  // open the device and trigger further hotplug events
+  for(std::vector<libusb_device*>::iterator i = arrivals.begin(); i != arrivals.end(); ++i)
+  {
+    if (device_cb)
+    {
+      device_cb(*i);
+    }
+    libusb_unref_device(*i);
+  }
+
+  return false; // remove the idle source
+}
+
+/* EOF */
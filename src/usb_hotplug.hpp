@@ -0,0 +1,108 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_USB_HOTPLUG_HPP
+#define HEADER_XBOXDRV_USB_HOTPLUG_HPP
+
+#include <boost/function.hpp>
+#include <glib.h>
+#include <libusb.h>
+#include <map>
+#include <pthread.h>
+#include <vector>
+
+struct XPadDevice;
+
+/** Keeps track of all USB devices on the system with the help of
+    libusb hotplug callbacks, devices are indexed by bus:dev and
+    vendor:product, so lookups don't have to go through
+    libusb_get_device_list() and read every device descriptor */
+class USBHotplug
+{
+private:
+  libusb_hotplug_callback_handle m_callback_handle;
+
+  /** hotplug callbacks come from whichever thread handles libusb events */
+  pthread_mutex_t m_mutex;
+
+  /** key is bus << 8 | dev, holds a reference to each device */
+  typedef std::map<uint16_t, libusb_device*> PathIndex;
+  PathIndex m_by_path;
+
+  /** key is vendor << 16 | product, devices are in order of arrival */
+  typedef std::map<uint32_t, std::vector<libusb_device*> > IdIndex;
+  IdIndex m_by_id;
+
+  /** all devices along with their vendor:product key in order of
+      arrival, which for the devices present at startup is the order
+      of libusb_get_device_list(), find_xpad_device() counts --id in
+      this order, so that it picks the same device as without
+      hotplug */
+  typedef std::vector<std::pair<libusb_device*, uint32_t> > DeviceList;
+  DeviceList m_devices;
+
+  /** devices that arrived, but haven't been passed to m_device_cb yet */
+  std::vector<libusb_device*> m_arrivals;
+  guint m_idle_source;
+
+  boost::function<void (libusb_device*)> m_device_cb;
+
+public:
+  /** Returns true if the libusb in use supports hotplug callbacks */
+  static bool is_supported();
+
+  USBHotplug();
+  ~USBHotplug();
+
+  /** \a device_cb is called from the glib main loop for every device
+      already present and for every device that arrives later on, an
+      empty function disables the callback */
+  void set_device_callback(const boost::function<void (libusb_device*)>& device_cb);
+
+  /** All find functions return a referenced device, the caller must
+      libusb_unref_device() it, NULL is returned when nothing matches */
+  libusb_device* find_device_by_path(uint8_t busnum, uint8_t devnum);
+  libusb_device* find_device_by_id(int id, uint16_t vendor_id, uint16_t product_id);
+  libusb_device* find_xpad_device(int id, XPadDevice* type);
+
+private:
+  void add_device(libusb_device* dev);
+  void remove_device(libusb_device* dev);
+
+  void on_hotplug(libusb_device* dev, libusb_hotplug_event event);
+  static int LIBUSB_CALL on_hotplug_wrap(libusb_context* ctx, libusb_device* dev,
+                                         libusb_hotplug_event event, void* userdata)
+  {
+    static_cast<USBHotplug*>(userdata)->on_hotplug(dev, event);
+    return 0; // keep the callback registered
+  }
+
+  bool on_idle();
+  static gboolean on_idle_wrap(gpointer userdata) {
+    return static_cast<USBHotplug*>(userdata)->on_idle();
+  }
+
+private:
+  USBHotplug(const USBHotplug&);
+  USBHotplug& operator=(const USBHotplug&);
+};
+
+#endif
+
+/* EOF */
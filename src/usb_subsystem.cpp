@@ -21,13 +21,20 @@
 #include <stdexcept>
 #include <boost/format.hpp>
 
+#include "controller/usb_controller.hpp"
 #include "options.hpp"
 #include "raise_exception.hpp"
 #include "usb_gsource.hpp"
 #include "usb_helper.hpp"
+#include "usb_hotplug.hpp"
+#include "usb_thread.hpp"
+#include "usb_trace_writer.hpp"
 
-USBSubsystem::USBSubsystem() :
-  m_usb_gsource()
+USBSubsystem::USBSubsystem(const Options& opts) :
+  m_usb_gsource(),
+  m_usb_thread(),
+  m_usb_hotplug(),
+  m_usb_trace()
 {
   int ret = libusb_init(NULL);
   if (ret != LIBUSB_SUCCESS)
@@ -35,15 +42,73 @@ USBSubsystem::USBSubsystem() :
     raise_exception(std::runtime_error, "libusb_init() failed: " << usb_strerror(ret));
   }
 
-  m_usb_gsource.reset(new USBGSource);
-  m_usb_gsource->attach(NULL);
+  if (opts.usb_thread)
+  {
+    USBController::set_event_thread(true);
+    m_usb_thread.reset(new USBThread(opts.usb_thread_priority == Options::kPriorityRealtime));
+  }
+  else
+  {
+    USBController::set_event_thread(false);
+    m_usb_gsource.reset(new USBGSource);
+    m_usb_gsource->attach(NULL);
+  }
+
+  if (opts.usb_hotplug)
+  {
+    if (!USBHotplug::is_supported())
+    {
+      log_warn("libusb doesn't support hotplug, falling back to scanning the device list");
+    }
+    else
+    {
+      m_usb_hotplug.reset(new USBHotplug);
+    }
+  }
+
+  if (!opts.usb_trace.empty())
+  {
+    log_info("recording USB transfers to " << opts.usb_trace);
+    m_usb_trace.reset(new USBTraceWriter(opts.usb_trace));
+  }
+  USBController::set_trace_writer(m_usb_trace.get());
 }
 
 USBSubsystem::~USBSubsystem()
 {
+  m_usb_thread.reset();
   m_usb_gsource.reset();
+  m_usb_hotplug.reset();
+  USBController::set_trace_writer(0);
+  m_usb_trace.reset();
   libusb_exit(NULL);
 }
+
+bool
+USBSubsystem::has_hotplug() const
+{
+  return m_usb_hotplug.get() != 0;
+}
+
+void
+USBSubsystem::set_device_callback(const boost::function<void (libusb_device*)>& device_cb)
+{
+  assert(m_usb_hotplug);
+  m_usb_hotplug->set_device_callback(device_cb);
+}
+
+libusb_device*
+USBSubsystem::find_device_by_path(uint8_t busnum, uint8_t devnum)
+{
+  if (m_usb_hotplug)
+  {
+    return m_usb_hotplug->find_device_by_path(busnum, devnum);
+  }
+  else
+  {
+    return usb_find_device_by_path(busnum, devnum);
+  }
+}
 
 void
 USBSubsystem::find_controller(libusb_device** dev, XPadDevice& dev_type, const Options& opts)
@@ -111,6 +176,12 @@ USBSubsystem::find_controller_by_path(const std::string& busid_str, const std::s
   int busid = boost::lexical_cast<int>(busid_str);
   int devid = boost::lexical_cast<int>(devid_str);
 
+  if (m_usb_hotplug)
+  {
+    *xbox_device = m_usb_hotplug->find_device_by_path(static_cast<uint8_t>(busid), static_cast<uint8_t>(devid));
+    return *xbox_device != 0;
+  }
+
   libusb_device** list;
   ssize_t num_devices = libusb_get_device_list(NULL, &list);
 
@@ -137,6 +208,14 @@ USBSubsystem::find_controller_by_path(const std::string& busid_str, const std::s
 bool
 USBSubsystem::find_controller_by_id(int id, int vendor_id, int product_id, libusb_device** xbox_device)
 {
+  if (m_usb_hotplug)
+  {
+    *xbox_device = m_usb_hotplug->find_device_by_id(id, 
+                                                    static_cast<uint16_t>(vendor_id), 
+                                                    static_cast<uint16_t>(product_id));
+    return *xbox_device != 0;
+  }
+
   libusb_device** list;
   ssize_t num_devices = libusb_get_device_list(NULL, &list);
 
@@ -179,6 +258,12 @@ USBSubsystem::find_controller_by_id(int id, int vendor_id, int product_id, libus
 bool
 USBSubsystem::find_xbox360_controller(int id, libusb_device** xbox_device, XPadDevice* type)
 {
+  if (m_usb_hotplug)
+  {
+    *xbox_device = m_usb_hotplug->find_xpad_device(id, type);
+    return *xbox_device != 0;
+  }
+
   libusb_device** list;
   ssize_t num_devices = libusb_get_device_list(NULL, &list);
 
@@ -195,24 +280,21 @@ USBSubsystem::find_xbox360_controller(int id, libusb_device** xbox_device, XPadD
     }
     else
     {
-      for(int i = 0; i < xpad_devices_count; ++i)
+      XPadDevice dev_type;
+      if (find_xpad_device(desc.idVendor, desc.idProduct, &dev_type))
       {
-        if (desc.idVendor  == xpad_devices[i].idVendor &&
-            desc.idProduct == xpad_devices[i].idProduct)
+        if (id_count == id)
+        {
+          *xbox_device = dev;
+          *type        = dev_type;
+          // increment ref count, user must free the device
+          libusb_ref_device(*xbox_device);
+          libusb_free_device_list(list, 1 /* unref_devices */);
+          return true;
+        }
+        else
         {
-          if (id_count == id)
-          {
-            *xbox_device = dev;
-            *type        = xpad_devices[i];
-            // increment ref count, user must free the device
-            libusb_ref_device(*xbox_device);
-            libusb_free_device_list(list, 1 /* unref_devices */);
-            return true;
-          }
-          else
-          {
-            id_count += 1;
-          }
+          id_count += 1;
         }
       }
     }
@@ -20,28 +20,51 @@
 #define HEADER_XBOXDRV_USB_SUBSYSTEM_HPP
 
 #include <libusb.h>
+#include <boost/function.hpp>
 #include <boost/scoped_ptr.hpp>
 
 #include "xpad_device.hpp"
 
 class USBGSource;
+class USBHotplug;
+class USBThread;
+class USBTraceWriter;
 class Options;
 
 class USBSubsystem
 {
 private:
   boost::scoped_ptr<USBGSource> m_usb_gsource;
+  boost::scoped_ptr<USBThread>  m_usb_thread;
+  boost::scoped_ptr<USBHotplug> m_usb_hotplug;
+  boost::scoped_ptr<USBTraceWriter> m_usb_trace;
 
 public:
-  USBSubsystem();
+  /** libusb events are either handled in the glib main loop or, with
+      Options::usb_thread, in a separate thread */
+  USBSubsystem(const Options& opts);
   ~USBSubsystem();
 
 public:
-  static void find_controller(libusb_device** dev, XPadDevice& dev_type, const Options& opts);
-  static bool find_controller_by_path(const std::string& busid, const std::string& devid,
-                                      libusb_device** xbox_device);
-  static bool find_controller_by_id(int id, int vendor_id, int product_id, libusb_device** xbox_device);
-  static bool find_xbox360_controller(int id, libusb_device** xbox_device, XPadDevice* type);
+  /** The find functions use the hotplug device index when
+      Options::usb_hotplug is set and otherwise scan the devices
+      returned by libusb_get_device_list() */
+  void find_controller(libusb_device** dev, XPadDevice& dev_type, const Options& opts);
+  bool find_controller_by_path(const std::string& busid, const std::string& devid,
+                               libusb_device** xbox_device);
+  bool find_controller_by_id(int id, int vendor_id, int product_id, libusb_device** xbox_device);
+  bool find_xbox360_controller(int id, libusb_device** xbox_device, XPadDevice* type);
+
+  /** Returns a referenced device or NULL */
+  libusb_device* find_device_by_path(uint8_t busnum, uint8_t devnum);
+
+  /** Returns true when devices are discovered via libusb hotplug
+      callbacks, see set_device_callback() */
+  bool has_hotplug() const;
+
+  /** \a device_cb is called from the main loop for every device that
+      is present or arrives later on, only available with has_hotplug() */
+  void set_device_callback(const boost::function<void (libusb_device*)>& device_cb);
 
 private:
   USBSubsystem(const USBSubsystem&);
@@ -0,0 +1,81 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2012 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "usb_thread.hpp"
+
+#include <libusb.h>
+#include <sched.h>
+#include <stdexcept>
+#include <string.h>
+
+#include "raise_exception.hpp"
+#include "usb_helper.hpp"
+
+USBThread::USBThread(bool realtime) :
+  m_thread(),
+  m_quit(0)
+{
+  int ret = pthread_create(&m_thread, NULL, &USBThread::run_wrap, this);
+  if (ret != 0)
+  {
+    raise_exception(std::runtime_error, "pthread_create() failed: " << strerror(ret));
+  }
+
+  if (realtime)
+  {
+    log_info("enabling realtime priority scheduling for the USB thread");
+
+    int policy = SCHED_FIFO;
+
+    struct sched_param param;
+    memset(&param, 0, sizeof(struct sched_param));
+    param.sched_priority = sched_get_priority_max(policy);
+
+    ret = pthread_setschedparam(m_thread, policy, &param);
+    if (ret != 0)
+    {
+      log_error("pthread_setschedparam() failed: " << strerror(ret));
+    }
+  }
+}
+
+USBThread::~USBThread()
+{
+  g_atomic_int_set(&m_quit, 1);
+  pthread_join(m_thread, NULL);
+}
+
+void
+USBThread::run()
+{
+  while (!g_atomic_int_get(&m_quit))
+  {
+    // wake up now and then to check for m_quit
+    struct timeval tv;
+    tv.tv_sec  = 0;
+    tv.tv_usec = 100 * 1000;
+
+    int ret = libusb_handle_events_timeout(NULL, &tv);
+    if (ret != LIBUSB_SUCCESS && ret != LIBUSB_ERROR_INTERRUPTED)
+    {
+      log_error("libusb_handle_events_timeout() failed: " << usb_strerror(ret));
+    }
+  }
+}
+
+/* EOF */
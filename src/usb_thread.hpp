@@ -0,0 +1,52 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2012 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_XBOXDRV_USB_THREAD_HPP
+#define HEADER_XBOXDRV_USB_THREAD_HPP
+
+#include <glib.h>
+#include <pthread.h>
+
+/** Runs libusb event handling in a thread of its own, as alternative
+    to USBGSource, so that USB completions don't have to wait for
+    whatever else is going on in the glib main loop */
+class USBThread
+{
+private:
+  pthread_t m_thread;
+  volatile gint m_quit;
+
+public:
+  USBThread(bool realtime);
+  ~USBThread();
+
+private:
+  void run();
+  static void* run_wrap(void* userdata) {
+    static_cast<USBThread*>(userdata)->run();
+    return NULL;
+  }
+
+private:
+  USBThread(const USBThread&);
+  USBThread& operator=(const USBThread&);
+};
+
+#endif
+
+/* EOF */
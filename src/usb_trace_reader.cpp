@@ -0,0 +1,97 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "usb_trace_reader.hpp"
+
+#include <stdexcept>
+#include <string.h>
+
+#include "raise_exception.hpp"
+#include "usb_trace_writer.hpp"
+
+namespace {
+
+uint16_t get_le16(const uint8_t* data)
+{
+  return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+uint32_t get_le32(const uint8_t* data)
+{
+  return get_le16(data) | (static_cast<uint32_t>(get_le16(data + 2)) << 16);
+}
+
+uint64_t get_le64(const uint8_t* data)
+{
+  return get_le32(data) | (static_cast<uint64_t>(get_le32(data + 4)) << 32);
+}
+
+} // namespace
+
+USBTraceReader::USBTraceReader(const std::string& filename) :
+  m_filename(filename),
+  m_in(filename.c_str(), std::ios::binary)
+{
+  if (!m_in)
+  {
+    raise_exception(std::runtime_error, "failed to open USB trace: " << m_filename);
+  }
+  else
+  {
+    uint8_t header[16];
+    if (!m_in.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+        memcmp(header, "XDRVTRC\0", 8) != 0)
+    {
+      raise_exception(std::runtime_error, m_filename << ": not a USB trace file");
+    }
+    else if (get_le32(header + 8) != USBTraceWriter::kVersion)
+    {
+      raise_exception(std::runtime_error, m_filename << ": unsupported USB trace version " << get_le32(header + 8));
+    }
+  }
+}
+
+bool
+USBTraceReader::read(USBTraceRecord* record)
+{
+  uint8_t header[16];
+  if (!m_in.read(reinterpret_cast<char*>(header), sizeof(header)))
+  {
+    return false;
+  }
+  else
+  {
+    record->timestamp = get_le64(header);
+    record->busnum    = header[8];
+    record->devnum    = header[9];
+    record->type      = header[10];
+    record->endpoint  = header[11];
+
+    record->data.resize(get_le16(header + 12));
+    if (!record->data.empty() &&
+        !m_in.read(reinterpret_cast<char*>(&record->data[0]), record->data.size()))
+    {
+      return false;
+    }
+
+    return true;
+  }
+}
+
+/* EOF */
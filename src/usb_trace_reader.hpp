@@ -0,0 +1,70 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_USB_TRACE_READER_HPP
+#define HEADER_XBOXDRV_USB_TRACE_READER_HPP
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/** A single transfer from a trace written by USBTraceWriter */
+struct USBTraceRecord
+{
+  uint64_t timestamp;
+  uint8_t  busnum;
+  uint8_t  devnum;
+  uint8_t  type;
+  uint8_t  endpoint;
+  std::vector<uint8_t> data;
+
+  USBTraceRecord() :
+    timestamp(0),
+    busnum(0),
+    devnum(0),
+    type(0),
+    endpoint(0),
+    data()
+  {}
+};
+
+/** Reads back the trace files written by USBTraceWriter, see there
+    for the file format */
+class USBTraceReader
+{
+private:
+  std::string m_filename;
+  std::ifstream m_in;
+
+public:
+  USBTraceReader(const std::string& filename);
+
+  /** Reads the next record into \a record, returns false at the end
+      of the file, a truncated last record is treated as end of file */
+  bool read(USBTraceRecord* record);
+
+private:
+  USBTraceReader(const USBTraceReader&);
+  USBTraceReader& operator=(const USBTraceReader&);
+};
+
+#endif
+
+/* EOF */
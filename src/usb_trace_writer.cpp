@@ -0,0 +1,179 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "usb_trace_writer.hpp"
+
+#include <errno.h>
+#include <glib.h>
+#include <stdexcept>
+#include <string.h>
+#include <time.h>
+
+#include "log.hpp"
+#include "raise_exception.hpp"
+
+namespace {
+
+/** the background thread is woken up once this much data is queued */
+const size_t kFlushSize  = 64 * 1024;
+
+/** records are dropped when the writer can't keep up */
+const size_t kBufferSize = 4 * 1024 * 1024;
+
+const size_t kRecordHeaderSize = 16;
+
+void put_le16(std::vector<uint8_t>& buf, uint16_t v)
+{
+  buf.push_back(static_cast<uint8_t>(v));
+  buf.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void put_le32(std::vector<uint8_t>& buf, uint32_t v)
+{
+  put_le16(buf, static_cast<uint16_t>(v));
+  put_le16(buf, static_cast<uint16_t>(v >> 16));
+}
+
+void put_le64(std::vector<uint8_t>& buf, uint64_t v)
+{
+  put_le32(buf, static_cast<uint32_t>(v));
+  put_le32(buf, static_cast<uint32_t>(v >> 32));
+}
+
+} // namespace
+
+USBTraceWriter::USBTraceWriter(const std::string& filename) :
+  m_out(),
+  m_thread(),
+  m_mutex(),
+  m_cond(),
+  m_buffer(),
+  m_pending(),
+  m_quit(false),
+  m_dropped(0)
+{
+  m_out = fopen(filename.c_str(), "wb");
+  if (!m_out)
+  {
+    raise_exception(std::runtime_error, "failed to open USB trace file: " << filename << ": " << strerror(errno));
+  }
+
+  m_buffer.reserve(kBufferSize);
+  m_pending.reserve(kBufferSize);
+
+  // file header
+  const char magic[8] = { 'X', 'D', 'R', 'V', 'T', 'R', 'C', '\0' };
+  m_buffer.insert(m_buffer.end(), magic, magic + sizeof(magic));
+  put_le32(m_buffer, kVersion);
+  put_le32(m_buffer, 0);
+
+  pthread_mutex_init(&m_mutex, NULL);
+  pthread_cond_init(&m_cond, NULL);
+
+  int ret = pthread_create(&m_thread, NULL, &USBTraceWriter::run_wrap, this);
+  if (ret != 0)
+  {
+    pthread_cond_destroy(&m_cond);
+    pthread_mutex_destroy(&m_mutex);
+    fclose(m_out);
+    raise_exception(std::runtime_error, "pthread_create() failed: " << strerror(ret));
+  }
+}
+
+USBTraceWriter::~USBTraceWriter()
+{
+  pthread_mutex_lock(&m_mutex);
+  m_quit = true;
+  pthread_cond_signal(&m_cond);
+  pthread_mutex_unlock(&m_mutex);
+
+  pthread_join(m_thread, NULL);
+
+  pthread_cond_destroy(&m_cond);
+  pthread_mutex_destroy(&m_mutex);
+  fclose(m_out);
+
+  if (m_dropped)
+  {
+    log_warn("USB trace writer couldn't keep up, " << m_dropped << " records were dropped");
+  }
+}
+
+void
+USBTraceWriter::record(RecordType type, uint8_t busnum, uint8_t devnum, uint8_t endpoint,
+                       const uint8_t* data, int len)
+{
+  const uint64_t timestamp = static_cast<uint64_t>(g_get_monotonic_time());
+
+  pthread_mutex_lock(&m_mutex);
+  if (m_buffer.size() + kRecordHeaderSize + len > kBufferSize)
+  {
+    m_dropped += 1;
+  }
+  else
+  {
+    put_le64(m_buffer, timestamp);
+    m_buffer.push_back(busnum);
+    m_buffer.push_back(devnum);
+    m_buffer.push_back(static_cast<uint8_t>(type));
+    m_buffer.push_back(endpoint);
+    put_le16(m_buffer, static_cast<uint16_t>(len));
+    put_le16(m_buffer, 0);
+    m_buffer.insert(m_buffer.end(), data, data + len);
+
+    if (m_buffer.size() >= kFlushSize)
+    {
+      pthread_cond_signal(&m_cond);
+    }
+  }
+  pthread_mutex_unlock(&m_mutex);
+}
+
+void
+USBTraceWriter::run()
+{
+  bool quit = false;
+  while (!quit)
+  {
+    pthread_mutex_lock(&m_mutex);
+    if (!m_quit && m_buffer.size() < kFlushSize)
+    {
+      // flush at least once a second, so short traces aren't lost
+      struct timespec deadline;
+      clock_gettime(CLOCK_REALTIME, &deadline);
+      deadline.tv_sec += 1;
+      pthread_cond_timedwait(&m_cond, &m_mutex, &deadline);
+    }
+    m_pending.swap(m_buffer);
+    quit = m_quit;
+    pthread_mutex_unlock(&m_mutex);
+
+    if (!m_pending.empty())
+    {
+      if (fwrite(&m_pending[0], 1, m_pending.size(), m_out) != m_pending.size())
+      {
+        log_error("failed to write USB trace: " << strerror(errno));
+      }
+      fflush(m_out);
+      m_pending.clear();
+    }
+  }
+}
+
+/* EOF */
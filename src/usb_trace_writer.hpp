@@ -0,0 +1,94 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_XBOXDRV_USB_TRACE_WRITER_HPP
+#define HEADER_XBOXDRV_USB_TRACE_WRITER_HPP
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+/** Records raw USB traffic into a binary trace file, records are
+    collected in memory and written out by a background thread, so
+    recording only costs a memcpy in the USB completion path.
+
+    File layout, all values little endian:
+
+      header: char magic[8] = "XDRVTRC\0", uint32 version, uint32 reserved
+      record: uint64 timestamp in microseconds (monotonic clock)
+              uint8  bus number
+              uint8  device address
+              uint8  record type (see RecordType)
+              uint8  endpoint address, including the direction bit
+              uint16 payload length
+              uint16 reserved
+              uint8  payload[length]
+
+    The payload of control transfers includes the 8 byte setup packet. */
+class USBTraceWriter
+{
+public:
+  enum RecordType {
+    kRecordIn      = 0,
+    kRecordOut     = 1,
+    kRecordControl = 2
+  };
+
+  static const uint32_t kVersion = 1;
+
+private:
+  FILE* m_out;
+
+  pthread_t m_thread;
+  pthread_mutex_t m_mutex;
+  pthread_cond_t  m_cond;
+
+  /** records waiting to be written, guarded by m_mutex */
+  std::vector<uint8_t> m_buffer;
+
+  /** records currently being written by the background thread */
+  std::vector<uint8_t> m_pending;
+
+  bool m_quit;
+  int  m_dropped;
+
+public:
+  USBTraceWriter(const std::string& filename);
+  ~USBTraceWriter();
+
+  void record(RecordType type, uint8_t busnum, uint8_t devnum, uint8_t endpoint,
+              const uint8_t* data, int len);
+
+private:
+  void run();
+  static void* run_wrap(void* userdata) {
+    static_cast<USBTraceWriter*>(userdata)->run();
+    return NULL;
+  }
+
+private:
+  USBTraceWriter(const USBTraceWriter&);
+  USBTraceWriter& operator=(const USBTraceWriter&);
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,122 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2012 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "usb_transfer_pool.hpp"
+
+#include <new>
+#include <stdlib.h>
+
+USBTransferPool::USBTransferPool(int buffer_size, int count) :
+  m_buffer_size(buffer_size),
+  m_max_free(count),
+  m_free()
+{
+  m_free.reserve(count);
+  try
+  {
+    for(int i = 0; i < count; ++i)
+    {
+      m_free.push_back(create(m_buffer_size));
+    }
+  }
+  catch(...)
+  {
+    for(std::vector<libusb_transfer*>::iterator it = m_free.begin(); it != m_free.end(); ++it)
+    {
+      destroy(*it);
+    }
+    throw;
+  }
+}
+
+USBTransferPool::~USBTransferPool()
+{
+  for(std::vector<libusb_transfer*>::iterator it = m_free.begin(); it != m_free.end(); ++it)
+  {
+    destroy(*it);
+  }
+}
+
+libusb_transfer*
+USBTransferPool::create(int buffer_size)
+{
+  libusb_transfer* transfer = libusb_alloc_transfer(0);
+  if (!transfer)
+  {
+    throw std::bad_alloc();
+  }
+
+  transfer->buffer = static_cast<uint8_t*>(malloc(sizeof(uint8_t) * buffer_size));
+  if (!transfer->buffer)
+  {
+    libusb_free_transfer(transfer);
+    throw std::bad_alloc();
+  }
+
+  return transfer;
+}
+
+void
+USBTransferPool::destroy(libusb_transfer* transfer)
+{
+  transfer->flags |= LIBUSB_TRANSFER_FREE_BUFFER;
+  libusb_free_transfer(transfer);
+}
+
+libusb_transfer*
+USBTransferPool::acquire(int len)
+{
+  if (len > m_buffer_size)
+  {
+    // too large for the pool, give out a one-off transfer
+    libusb_transfer* transfer = create(len);
+    transfer->flags |= LIBUSB_TRANSFER_FREE_BUFFER;
+    return transfer;
+  }
+  else if (m_free.empty())
+  {
+    // pool is exhausted, release() frees the new transfer again
+    // unless the pool has room for it by then
+    return create(m_buffer_size);
+  }
+  else
+  {
+    libusb_transfer* transfer = m_free.back();
+    m_free.pop_back();
+    return transfer;
+  }
+}
+
+void
+USBTransferPool::release(libusb_transfer* transfer)
+{
+  if (transfer->flags & LIBUSB_TRANSFER_FREE_BUFFER)
+  {
+    libusb_free_transfer(transfer);
+  }
+  else if (static_cast<int>(m_free.size()) >= m_max_free)
+  {
+    destroy(transfer);
+  }
+  else
+  {
+    m_free.push_back(transfer);
+  }
+}
+
+/* EOF */
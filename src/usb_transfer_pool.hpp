@@ -0,0 +1,66 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2012 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_XBOXDRV_USB_TRANSFER_POOL_HPP
+#define HEADER_XBOXDRV_USB_TRANSFER_POOL_HPP
+
+#include <libusb.h>
+#include <vector>
+
+/** Keeps a set of libusb_transfer objects with preallocated payload
+    buffers around, so that small output transfers (rumble, LED,
+    control requests) can be recycled instead of being allocated and
+    freed for every single write */
+class USBTransferPool
+{
+private:
+  int m_buffer_size;
+  int m_max_free;
+  std::vector<libusb_transfer*> m_free;
+
+public:
+  /** \a buffer_size is the payload size of each pooled transfer,
+      including the 8 byte setup packet for control transfers. The
+      pool starts out with \a count transfers and never keeps more
+      than that, extra transfers handed out while it was exhausted
+      are freed on release(). Throws std::bad_alloc when out of
+      memory. */
+  USBTransferPool(int buffer_size, int count);
+  ~USBTransferPool();
+
+  /** Returns a transfer with a buffer of at least \a len bytes,
+      requests larger then the pool buffer size get a one-off
+      transfer that is freed on release() */
+  libusb_transfer* acquire(int len);
+
+  /** Returns \a transfer to the pool, the transfer must no longer be
+      in flight */
+  void release(libusb_transfer* transfer);
+
+private:
+  libusb_transfer* create(int buffer_size);
+  void destroy(libusb_transfer* transfer);
+
+private:
+  USBTransferPool(const USBTransferPool&);
+  USBTransferPool& operator=(const USBTransferPool&);
+};
+
+#endif
+
+/* EOF */
@@ -31,6 +31,7 @@
 
 #include "command_line_options.hpp"
 #include "controller/evdev_controller.hpp"
+#include "controller/usb_controller.hpp"
 #include "controller_factory.hpp"
 #include "controller_thread.hpp"
 #include "evdev_helper.hpp"
@@ -70,38 +71,34 @@ Xboxdrv::run_list_controller()
     // FIXME: we silently ignore failures
     if (libusb_get_device_descriptor(dev, &desc) == LIBUSB_SUCCESS)
     {
-      for(int i = 0; i < xpad_devices_count; ++i)
+      XPadDevice dev_type;
+      if (find_xpad_device(desc.idVendor, desc.idProduct, &dev_type))
       {
-        if (desc.idVendor  == xpad_devices[i].idVendor &&
-            desc.idProduct == xpad_devices[i].idProduct)
+        if (dev_type.type == GAMEPAD_XBOX360_WIRELESS)
         {
-          if (xpad_devices[i].type == GAMEPAD_XBOX360_WIRELESS)
+          for(int wid = 0; wid < 4; ++wid)
           {
-            for(int wid = 0; wid < 4; ++wid)
-            {
-              std::cout << boost::format(" %2d |  %2d |   0x%04x |    0x%04x | %s (Port: %s)")
-                % id
-                % wid
-                % int(xpad_devices[i].idVendor)
-                % int(xpad_devices[i].idProduct)
-                % xpad_devices[i].name 
-                % wid
-                        << std::endl;
-            }
-          }
-          else
-          {
-            std::cout << boost::format(" %2d |  %2d |   0x%04x |    0x%04x | %s")
+            std::cout << boost::format(" %2d |  %2d |   0x%04x |    0x%04x | %s (Port: %s)")
               % id
-              % 0
-              % int(xpad_devices[i].idVendor)
-              % int(xpad_devices[i].idProduct)
-              % xpad_devices[i].name 
+              % wid
+              % int(dev_type.idVendor)
+              % int(dev_type.idProduct)
+              % dev_type.name 
+              % wid
                       << std::endl;
           }
-          id += 1;
-          break;
         }
+        else
+        {
+          std::cout << boost::format(" %2d |  %2d |   0x%04x |    0x%04x | %s")
+            % id
+            % 0
+            % int(dev_type.idVendor)
+            % int(dev_type.idProduct)
+            % dev_type.name 
+                    << std::endl;
+        }
+        id += 1;
       }
     }
   }
@@ -195,7 +192,7 @@ Xboxdrv::run_main(const Options& opts)
     print_copyright();
   }
 
-  USBSubsystem usb_subsystem;
+  USBSubsystem usb_subsystem(opts);
   XboxdrvMain xboxdrv_main(usb_subsystem, opts);
   xboxdrv_main.run();
 }
@@ -213,7 +210,7 @@ Xboxdrv::run_daemon(const Options& opts)
     libusb_set_debug(NULL, 3);
   }
 
-  USBSubsystem usb_subsystem;
+  USBSubsystem usb_subsystem(opts);
   if (!opts.detach)
   {
     XboxdrvDaemon daemon(usb_subsystem, opts);
@@ -342,6 +339,7 @@ Xboxdrv::main(int argc, char** argv)
     cmd_parser.parse_args(argc, argv, &opts);
 
     set_scheduling(opts);
+    USBController::set_read_queue_depth(opts.usb_read_queue);
 
     switch(opts.mode)
     {
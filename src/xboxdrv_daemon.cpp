@@ -20,6 +20,7 @@
 
 #include <boost/bind.hpp>
 #include <boost/format.hpp>
+#include <boost/ref.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <fstream>
 #include <dbus/dbus-glib.h>
@@ -139,7 +140,17 @@ XboxdrvDaemon::run()
     init_uinput();
 
     UdevSubsystem udev_subsystem;
-    udev_subsystem.set_device_callback(boost::bind(&XboxdrvDaemon::process_match, this, _1));
+    if (m_usb_subsystem.has_hotplug())
+    {
+      // udev is still needed for the match rules, but devices are
+      // discovered through libusb
+      m_usb_subsystem.set_device_callback(boost::bind(&XboxdrvDaemon::process_usb_device, this,
+                                                      boost::ref(udev_subsystem), _1));
+    }
+    else
+    {
+      udev_subsystem.set_device_callback(boost::bind(&XboxdrvDaemon::process_match, this, _1));
+    }
 
     boost::scoped_ptr<DBusSubsystem> dbus_subsystem;
     if (m_opts.dbus != Options::kDBusDisabled)
@@ -182,6 +193,11 @@ XboxdrvDaemon::run()
     g_main_loop_run(m_gmain);
     log_debug("main loop exited");
 
+    if (m_usb_subsystem.has_hotplug())
+    {
+      m_usb_subsystem.set_device_callback(boost::function<void (libusb_device*)>());
+    }
+
     // get rid of active ControllerThreads before the subsystems shutdown
     m_inactive_controllers.clear();
     m_controller_slots.clear();
@@ -236,6 +252,50 @@ XboxdrvDaemon::process_match(struct udev_device* device)
   }
 }
 
+void
+XboxdrvDaemon::process_usb_device(UdevSubsystem& udev_subsystem, libusb_device* dev)
+{
+  libusb_device_descriptor desc;
+  int ret = libusb_get_device_descriptor(dev, &desc);
+  if (ret != LIBUSB_SUCCESS)
+  {
+    log_warn("libusb_get_device_descriptor() failed: " << usb_strerror(ret));
+  }
+  else
+  {
+    XPadDevice dev_type;
+    if (!find_xpad_device(desc.idVendor, desc.idProduct, &dev_type))
+    {
+      log_debug("ignoring " << boost::format("%04x:%04x") % desc.idVendor % desc.idProduct <<
+                " not a valid Xboxdrv device");
+    }
+    else
+    {
+      uint8_t busnum = libusb_get_bus_number(dev);
+      uint8_t devnum = libusb_get_device_address(dev);
+
+      udev_device* udev_dev = udev_subsystem.get_usb_device(busnum, devnum);
+      if (!udev_dev)
+      {
+        log_warn("couldn't find udev device for " << boost::format("%03d:%03d") 
+                 % static_cast<int>(busnum) % static_cast<int>(devnum));
+      }
+      else
+      {
+        try 
+        {
+          launch_controller_thread(udev_dev, dev_type, busnum, devnum);
+        }
+        catch(const std::exception& err)
+        {
+          log_error("failed to launch ControllerThread: " << err.what());
+        }
+        udev_device_unref(udev_dev);
+      }
+    }
+  }
+}
+
 void
 XboxdrvDaemon::init_uinput()
 {
@@ -337,7 +397,7 @@ XboxdrvDaemon::launch_controller_thread(udev_device* udev_dev,
                                         uint8_t busnum, uint8_t devnum)
 {
   // FIXME: results must be libusb_unref_device()'ed
-  libusb_device* dev = usb_find_device_by_path(busnum, devnum);
+  libusb_device* dev = m_usb_subsystem.find_device_by_path(busnum, devnum);
 
   if (!dev)
   {
@@ -24,6 +24,7 @@ extern "C" {
 }
 #include <boost/scoped_ptr.hpp>
 #include <glib.h>
+#include <libusb.h>
 
 #include "controller_slot_config.hpp"
 #include "controller_slot_ptr.hpp"
@@ -31,6 +32,7 @@ extern "C" {
 
 class Options;
 class UInput;
+class UdevSubsystem;
 class USBGSource;
 class USBSubsystem;
 struct XPadDevice;
@@ -73,6 +75,7 @@ private:
   ControllerSlotPtr find_free_slot(udev_device* dev);
 
   void process_match(struct udev_device* device);
+  void process_usb_device(UdevSubsystem& udev_subsystem, libusb_device* dev);
   void print_info(struct udev_device* device);
   void launch_controller_thread(udev_device* dev,
                                 const XPadDevice& dev_type, 
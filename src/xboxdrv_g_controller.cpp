@@ -119,6 +119,7 @@ xboxdrv_g_controller_set_config(XboxdrvGController* self, int config_num, GError
     try 
     {
       msg_proc->set_config(config_num);
+      self->controller->get_thread()->update_timeout();
       return TRUE;
     }
     catch(const std::exception& err)
@@ -90,6 +90,20 @@ XboxdrvMain::create_controller()
     m_dev_type.idProduct = 0;
     m_dev_type.name = "Evdev device";
   }
+  else if (!m_opts.replay_file.empty())
+  { // recorded USB trace, parsed by the real controller code
+    if (m_opts.gamepad_type == GAMEPAD_UNKNOWN)
+    {
+      throw std::runtime_error("--replay FILE option must be used in combination with --type TYPE option");
+    }
+
+    m_dev_type.type = m_opts.gamepad_type;
+    m_dev_type.idVendor  = static_cast<uint16_t>(m_opts.vendor_id  == -1 ? 0 : m_opts.vendor_id);
+    m_dev_type.idProduct = static_cast<uint16_t>(m_opts.product_id == -1 ? 0 : m_opts.product_id);
+    m_dev_type.name = "USB trace replay";
+
+    return ControllerFactory::create_replay(m_dev_type, m_opts.replay_file, m_opts);
+  }
   else if (m_opts.wiimote)
   {
 #ifdef HAVE_CWIID
@@ -105,7 +119,7 @@ XboxdrvMain::create_controller()
     // FIXME: this must be libusb_unref_device()'ed, child code must not keep a copy around
     libusb_device* dev = 0;
   
-    USBSubsystem::find_controller(&dev, m_dev_type, m_opts);
+    m_usb_subsystem.find_controller(&dev, m_dev_type, m_opts);
 
     if (!dev)
     {
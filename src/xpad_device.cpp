@@ -17,6 +17,8 @@
 */
 
 #include "xpad_device.hpp"
+
+#include <assert.h>
 
 // FIXME: We shouldn't check device-ids, but device class or so, to
 // automatically catch all third party stuff
@@ -130,18 +132,92 @@ XPadDevice xpad_devices[] = {
 
 const int xpad_devices_count = sizeof(xpad_devices)/sizeof(XPadDevice);
 
-bool find_xpad_device(uint16_t idVendor, uint16_t idProduct, XPadDevice* dev_type)
+namespace {
+
+/** Open addressing hash table over xpad_devices[], it is build during
+    static initialization, so lookups are a hash plus usually a single
+    probe instead of a walk over the whole table */
+class XPadDeviceIndex
 {
-  for(int i = 0; i < xpad_devices_count; ++i)
+private:
+  enum { kSize = 256 }; // power of two, at least twice the table size
+
+  /** index into xpad_devices[], -1 for empty slots */
+  int16_t m_slots[kSize];
+
+public:
+  XPadDeviceIndex()
+  {
+    assert(xpad_devices_count * 2 <= kSize);
+
+    for(int i = 0; i < kSize; ++i)
+    {
+      m_slots[i] = -1;
+    }
+
+    for(int i = 0; i < xpad_devices_count; ++i)
+    {
+      int slot = find_slot(xpad_devices[i].idVendor, xpad_devices[i].idProduct);
+      // some ids are listed twice, the first entry has to win as
+      // with the old linear search
+      if (m_slots[slot] == -1)
+      {
+        m_slots[slot] = static_cast<int16_t>(i);
+      }
+    }
+  }
+
+  const XPadDevice* find(uint16_t idVendor, uint16_t idProduct) const
   {
-    if (idVendor  == xpad_devices[i].idVendor &&
-        idProduct == xpad_devices[i].idProduct)
+    int slot = find_slot(idVendor, idProduct);
+    if (m_slots[slot] == -1)
     {
-      *dev_type = xpad_devices[i];
-      return true;
+      return 0;
+    }
+    else
+    {
+      return &xpad_devices[m_slots[slot]];
     }
   }
-  return false;
+
+private:
+  /** Returns the slot holding the given ids or the empty slot where
+      they would go */
+  int find_slot(uint16_t idVendor, uint16_t idProduct) const
+  {
+    const uint32_t key = (static_cast<uint32_t>(idVendor) << 16) | idProduct;
+    // Fibonacci hashing, the top bits of the product are the best mixed
+    int slot = static_cast<int>((key * 2654435761u) >> 24) & (kSize - 1);
+
+    while(m_slots[slot] != -1 &&
+          !(xpad_devices[m_slots[slot]].idVendor  == idVendor &&
+            xpad_devices[m_slots[slot]].idProduct == idProduct))
+    {
+      slot = (slot + 1) & (kSize - 1);
+    }
+
+    return slot;
+  }
+};
+
+// xpad_devices[] is constant initialized, so it is ready before this
+// runs even though both live in the same translation unit
+const XPadDeviceIndex xpad_device_index;
+
+} // namespace
+
+bool find_xpad_device(uint16_t idVendor, uint16_t idProduct, XPadDevice* dev_type)
+{
+  const XPadDevice* dev = xpad_device_index.find(idVendor, idProduct);
+  if (!dev)
+  {
+    return false;
+  }
+  else
+  {
+    *dev_type = *dev;
+    return true;
+  }
 }
-
+
 /* EOF */
@@ -32,7 +32,8 @@ struct XPadDevice
 };
 
 /** Search for an xpad device matching the \a idVendor, \a idProduct
-    values, the first \a skip matches will be ignored */
+    values, this is a hash lookup and doesn't walk xpad_devices[],
+    for ids listed multiple times the first entry is returned */
 bool find_xpad_device(uint16_t idVendor, uint16_t idProduct, XPadDevice* dev_type);
 
 extern XPadDevice xpad_devices[];
@@ -21,7 +21,7 @@
 #include <boost/tokenizer.hpp>
 #include <boost/lexical_cast.hpp>
 
-#include "axis_filter.hpp"
+#include "axis_filter_chain.hpp"
 
 int main(int argc, char** argv)
 {
@@ -32,7 +32,7 @@ int main(int argc, char** argv)
   }
   else
   {
-    std::vector<AxisFilterPtr> filters;
+    AxisFilterChain filters;
 
     std::string str = argv[1];
 
@@ -40,17 +40,14 @@ int main(int argc, char** argv)
     tokenizer tokens(str, boost::char_separator<char>("^", "", boost::keep_empty_tokens));
     for(tokenizer::iterator t = tokens.begin(); t != tokens.end(); ++t)
     {
-      filters.push_back(AxisFilter::from_string(*t));
+      filters.add(AxisFilter::from_string(*t));
     }
 
     std::string line;
     while(std::getline(std::cin, line))
     {
       int value = boost::lexical_cast<int>(line);
-      for(std::vector<AxisFilterPtr>::iterator i = filters.begin(); i != filters.end(); ++i)
-      {
-        value = (*i)->filter(value, -32768, 32767);
-      }
+      value = filters.filter(value, -32768, 32767);
       std::cout << value << std::endl;
     }
 
@@ -0,0 +1,132 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <iostream>
+#include <stdlib.h>
+
+#include "button_combination_map.hpp"
+#include "controller_message_descriptor.hpp"
+
+namespace {
+
+int errors = 0;
+
+typedef ButtonCombinationMap<int> Map;
+
+ControllerMessageDescriptor g_desc;
+
+/** Sets \a pressed and checks that exactly the mappings whose data is
+    listed in \a active are on */
+void check(Map& map, const std::string& pressed, const std::string& active)
+{
+  ButtonCombination combo = ButtonCombination::from_string(pressed);
+  combo.init(g_desc);
+  map.update(pressed.empty() ? std::bitset<256>() : combo.get_mask());
+
+  std::string got;
+  for(Map::const_iterator it = map.begin(); it != map.end(); ++it)
+  {
+    if (it->m_state)
+    {
+      got += static_cast<char>('0' + it->m_data);
+    }
+  }
+
+  if (got != active)
+  {
+    std::cout << "pressed '" << pressed << "': active " << got << ", expected " << active << std::endl;
+    errors += 1;
+  }
+}
+
+void init(Map& map, const char* combos[], int count)
+{
+  for(int i = 0; i < count; ++i)
+  {
+    map.add(ButtonCombination::from_string(combos[i]), i);
+  }
+  map.init(g_desc);
+}
+
+/** lb+a suppresses a, but not lb alone or b */
+void test_superset()
+{
+  const char* combos[] = { "gamepad.a", "gamepad.lb+gamepad.a", "gamepad.b" };
+  Map map;
+  init(map, combos, 3);
+
+  check(map, "", "");
+  check(map, "gamepad.a", "0");
+  check(map, "gamepad.lb+gamepad.a", "1");
+  check(map, "gamepad.lb+gamepad.a+gamepad.b", "12");
+  check(map, "gamepad.lb", "");
+  check(map, "gamepad.a+gamepad.b", "02");
+}
+
+/** the later of two equal bindings wins and suppresses the earlier,
+    also when the combination has a superset of its own */
+void test_duplicate()
+{
+  const char* combos[] = { "gamepad.a", "gamepad.a", "gamepad.lb+gamepad.a", "gamepad.lb+gamepad.a" };
+  Map map;
+  init(map, combos, 4);
+
+  check(map, "gamepad.a", "1");
+  check(map, "gamepad.lb+gamepad.a", "3");
+  check(map, "", "");
+}
+
+/** what is active only depends on what is held, not on the order the
+    buttons went down or up in */
+void test_release_order()
+{
+  const char* combos[] = { "gamepad.a", "gamepad.lb", "gamepad.lb+gamepad.a" };
+  Map map;
+  init(map, combos, 3);
+
+  // lb first, a first, release lb first, release a first
+  check(map, "gamepad.lb", "1");
+  check(map, "gamepad.lb+gamepad.a", "2");
+  check(map, "gamepad.a", "0");
+  check(map, "", "");
+
+  check(map, "gamepad.a", "0");
+  check(map, "gamepad.lb+gamepad.a", "2");
+  check(map, "gamepad.lb", "1");
+  check(map, "", "");
+}
+
+} // namespace
+
+int main()
+{
+  g_desc.key().put(KeyName("gamepad.a"));
+  g_desc.key().put(KeyName("gamepad.b"));
+  g_desc.key().put(KeyName("gamepad.lb"));
+
+  test_superset();
+  test_duplicate();
+  test_release_order();
+
+  std::cout << "errors: " << errors << std::endl;
+
+  return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* EOF */
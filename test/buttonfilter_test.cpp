@@ -52,7 +52,8 @@ int main(int argc, char** argv)
       values.push_back(boost::lexical_cast<int>(line));
     }
     
-    int time_step = duration / values.size();
+    // DURATION is given in msec, the filters count in usec
+    int time_step = duration * 1000 / static_cast<int>(values.size());
 
     for(std::vector<int>::const_iterator i = values.begin(); i != values.end(); ++i)
     {
@@ -0,0 +1,123 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <iostream>
+#include <stdlib.h>
+
+#include "controller_message.hpp"
+
+namespace {
+
+int errors = 0;
+
+void check(bool ok, const char* what)
+{
+  if (!ok)
+  {
+    std::cout << "failed: " << what << std::endl;
+    errors += 1;
+  }
+}
+
+/** Messages that only differ in how many zero slots they have
+    written are equal, a non-zero slot above the other message's
+    high-water mark is a change */
+void test_abs_high_water()
+{
+  ControllerMessage shorter;
+  shorter.set_abs(0, 5, -10, 10);
+  shorter.set_abs(1, 0, -10, 10);
+
+  ControllerMessage longer = shorter;
+  longer.set_abs(3, 0, 0, 0);
+  check(shorter.get_abs_count() == 2 && longer.get_abs_count() == 4, "abs count");
+  check(longer.get_abs(2) == 0 && longer.get_abs_min(2) == 0, "abs gap reads zero");
+
+  check(shorter == longer && longer == shorter, "zero abs tail compares equal");
+  check(!longer.update_changes(shorter), "zero abs tail is no change");
+  check(!shorter.update_changes(longer), "zero abs tail is no change, reversed");
+
+  longer.set_abs(3, 7, 0, 0);
+  check(shorter != longer && longer != shorter, "non-zero abs tail compares unequal");
+
+  check(longer.update_changes(shorter), "non-zero abs tail is a change");
+  check(longer.abs_changed(3) && !longer.abs_changed(0) && !longer.abs_changed(2), "abs tail change slot");
+
+  check(shorter.update_changes(longer), "non-zero abs tail is a change, reversed");
+  check(shorter.abs_changed(3) && !shorter.abs_changed(0), "abs tail change slot, reversed");
+
+  // a range in the tail is a change, but equality only looks at values
+  ControllerMessage ranged = shorter;
+  ranged.set_abs(2, 0, -1, 1);
+  check(ranged == shorter, "abs tail range compares equal");
+  check(ranged.update_changes(shorter) && ranged.abs_changed(2), "abs tail range is a change");
+}
+
+void test_rel_high_water()
+{
+  ControllerMessage shorter;
+  shorter.set_rel(0, 1);
+
+  ControllerMessage longer = shorter;
+  longer.set_rel(5, 0);
+  check(longer.get_rel_count() == 6, "rel count");
+
+  check(shorter == longer, "zero rel tail compares equal");
+  check(!longer.update_changes(shorter), "zero rel tail is no change");
+
+  longer.set_rel(5, -3);
+  check(shorter != longer, "non-zero rel tail compares unequal");
+  check(longer.update_changes(shorter) && longer.rel_changed(5) && !longer.rel_changed(0),
+        "non-zero rel tail is a change");
+  check(shorter.update_changes(longer) && shorter.rel_changed(5), "non-zero rel tail is a change, reversed");
+}
+
+/** Storage left over from before a clear() must not show */
+void test_clear()
+{
+  ControllerMessage msg;
+  msg.set_abs(5, 9, -10, 10);
+  msg.set_rel(5, 9);
+  msg.clear();
+
+  check(msg.get_abs_count() == 0 && msg.get_rel_count() == 0, "clear resets counts");
+
+  msg.set_abs(7, 1, -10, 10);
+  msg.set_rel(7, 1);
+  check(msg.get_abs(5) == 0 && msg.get_abs_max(5) == 0, "stale abs hidden");
+  check(msg.get_rel(5) == 0, "stale rel hidden");
+
+  ControllerMessage copy = msg;
+  check(copy == msg && copy.get_abs_count() == 8 && copy.get_abs(7) == 1, "copy");
+}
+
+} // namespace
+
+int main()
+{
+  test_abs_high_water();
+  test_rel_high_water();
+  test_clear();
+
+  std::cout << "errors: " << errors << std::endl;
+
+  return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* EOF */
@@ -0,0 +1,85 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <iostream>
+
+#include "controller_message.hpp"
+#include "controller_message_descriptor.hpp"
+#include "hid_report_descriptor.hpp"
+
+namespace {
+
+int errors = 0;
+
+void expect(const char* what, int value, int expected)
+{
+  if (value != expected)
+  {
+    std::cout << what << ": got " << value << ", expected " << expected << std::endl;
+    errors += 1;
+  }
+}
+
+} // namespace
+
+int main()
+{
+  // a typical cheap USB gamepad: two 8 bit axes, a hat and 12 buttons
+  const uint8_t descriptor[] = {
+    0x05, 0x01, 0x09, 0x05, 0xa1, 0x01,
+    0x15, 0x00, 0x26, 0xff, 0x00, 0x75, 0x08, 0x95, 0x02, 0x09, 0x30, 0x09, 0x31, 0x81, 0x02,
+    0x09, 0x39, 0x15, 0x00, 0x25, 0x07, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42,
+    0x75, 0x04, 0x95, 0x01, 0x81, 0x03,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x0c, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x0c, 0x81, 0x02,
+    0x75, 0x04, 0x95, 0x01, 0x81, 0x03,
+    0xc0
+  };
+
+  HIDReportDescriptor hid(descriptor, sizeof(descriptor));
+  std::vector<ReportField> layout = hid.get_layout();
+
+  expect("report id", hid.get_report_id(), -1);
+  expect("fields", static_cast<int>(layout.size()), 2 + 1 + 12);
+
+  ControllerMessageDescriptor desc;
+  ReportParser parser(layout, desc);
+  expect("min length", parser.get_min_length(), 5);
+
+  // X=0, Y=255, hat=2 (right), buttons 1 and 12
+  const uint8_t data[] = { 0x00, 0xff, 0x02, 0x01, 0x08 };
+  ControllerMessage msg;
+  expect("parse", parser.parse(data, sizeof(data), &msg), true);
+
+  int x = desc.abs().get(AbsName("evdev.ABS_X"));
+  expect("x",     msg.get_abs(x), 0);
+  expect("x max", msg.get_abs_max(x), 255);
+  expect("y",     msg.get_abs(desc.abs().get(AbsName("evdev.ABS_Y"))), 255);
+  expect("hat x", msg.get_abs(desc.abs().get(AbsName("evdev.ABS_HAT0X"))), 1);
+  expect("hat y", msg.get_abs(desc.abs().get(AbsName("evdev.ABS_HAT0Y"))), 0);
+
+  expect("button 1",  msg.get_key(desc.key().get(KeyName("evdev.BTN_A"))), 1);
+  expect("button 2",  msg.get_key(desc.key().get(KeyName("evdev.BTN_B"))), 0);
+  expect("button 12", msg.get_key(desc.key().get(KeyName("evdev.BTN_START"))), 1);
+
+  std::cout << errors << " errors" << std::endl;
+
+  return errors == 0 ? 0 : 1;
+}
+
+/* EOF */
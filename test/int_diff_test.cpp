@@ -0,0 +1,82 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+
+#include "int_diff.hpp"
+
+int main()
+{
+  int errors = 0;
+  int runs = 0;
+
+  srand(0);
+
+  // cover every length around the vector widths and every offset a
+  // difference can land on, compare against a plain loop
+  for(int count = 0; count <= 67; ++count)
+  {
+    for(int pos = -1; pos < count; ++pos)
+    {
+      int lhs[67];
+      int rhs[67];
+      for(int i = 0; i < count; ++i)
+      {
+        lhs[i] = rhs[i] = rand();
+      }
+      if (pos >= 0)
+      {
+        rhs[pos] += 1;
+      }
+      if (count > 0 && (rand() % 2))
+      {
+        lhs[count - 1] ^= 1;
+      }
+
+      uint32_t expected[3] = { 0, 0, 0 };
+      bool expected_any = false;
+      for(int i = 0; i < count; ++i)
+      {
+        if (lhs[i] != rhs[i])
+        {
+          expected[i / 32] |= 1u << (i % 32);
+          expected_any = true;
+        }
+      }
+
+      uint32_t mask[3] = { 0, 0, 0 };
+      bool any = int_diff(lhs, rhs, count, mask);
+
+      runs += 1;
+      if (any != expected_any || memcmp(mask, expected, sizeof(mask)) != 0)
+      {
+        std::cout << "mismatch: count=" << count << " pos=" << pos << std::endl;
+        errors += 1;
+      }
+    }
+  }
+
+  std::cout << runs << " runs, " << errors << " errors" << std::endl;
+
+  return errors == 0 ? 0 : 1;
+}
+
+/* EOF */
@@ -0,0 +1,165 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h>
+
+#include "controller_message.hpp"
+#include "controller_message_descriptor.hpp"
+#include "modifier/latency_modifier.hpp"
+
+namespace {
+
+int errors = 0;
+
+void check(bool ok, const std::string& test, int n, int got, int expected)
+{
+  if (!ok)
+  {
+    std::cout << test << ": " << n << ": got " << got << ", expected " << expected << std::endl;
+    errors += 1;
+  }
+}
+
+void init_descriptor(ControllerMessageDescriptor& desc)
+{
+  desc.abs().put(AbsName("gamepad.x1"));
+  desc.abs().put(AbsName("gamepad.y1"));
+  desc.key().put(KeyName("gamepad.a"));
+}
+
+/** a message that encodes \a n in the first axis and its parity in
+    the key, the second axis stays put */
+ControllerMessage make_msg(int n)
+{
+  ControllerMessage msg;
+  msg.set_abs(0, n, -32768, 32767);
+  msg.set_abs(1, 0, -32768, 32767);
+  msg.set_key(0, n % 2);
+  return msg;
+}
+
+/** The first message is the state until the latency has passed */
+void test_priming()
+{
+  ControllerMessageDescriptor desc;
+  init_descriptor(desc);
+  LatencyModifier modifier(10);
+  modifier.init(desc);
+
+  for(int n = 0; n < 20; ++n)
+  {
+    ControllerMessage msg = make_msg(100 + n);
+    modifier.update(1000, msg, desc);
+
+    const int expected = n < 10 ? 100 : 100 + n - 10;
+    check(msg.get_abs(0) == expected, "priming", n, msg.get_abs(0), expected);
+  }
+}
+
+/** Without latency every message goes through as is */
+void test_latency_zero()
+{
+  ControllerMessageDescriptor desc;
+  init_descriptor(desc);
+  LatencyModifier modifier(0);
+  modifier.init(desc);
+
+  for(int n = 0; n < 100; ++n)
+  {
+    ControllerMessage msg = make_msg(n);
+    modifier.update(1000, msg, desc);
+    check(msg.get_abs(0) == n, "latency-zero", n, msg.get_abs(0), n);
+    check(msg.get_key(0) == n % 2, "latency-zero-key", n, msg.get_key(0), n % 2);
+  }
+
+  check(modifier.get_next_update() == -1, "latency-zero-idle", 0, modifier.get_next_update(), -1);
+}
+
+/** Runs many times around the rings, the delay has to stay exact */
+void test_wraparound()
+{
+  ControllerMessageDescriptor desc;
+  init_descriptor(desc);
+  LatencyModifier modifier(5);
+  modifier.init(desc);
+
+  for(int n = 0; n < 10000; ++n)
+  {
+    ControllerMessage msg = make_msg(n);
+    modifier.update(1000, msg, desc);
+
+    const int expected = std::max(0, n - 5);
+    check(msg.get_abs(0) == expected, "wraparound", n, msg.get_abs(0), expected);
+    check(msg.get_key(0) == expected % 2, "wraparound-key", n, msg.get_key(0), expected % 2);
+  }
+
+  // without further input the queue drains on its own
+  ControllerMessage msg;
+  for(int i = 0; i < 10; ++i)
+  {
+    msg = make_msg(9999);
+    modifier.update(1000, msg, desc);
+  }
+  check(msg.get_abs(0) == 9999, "wraparound-drain", 0, msg.get_abs(0), 9999);
+  check(modifier.get_next_update() == -1, "wraparound-idle", 0, modifier.get_next_update(), -1);
+}
+
+/** Input much faster than the buffers are sized for, changes have to
+    come out early, but in order and never later than the latency */
+void test_early_release()
+{
+  ControllerMessageDescriptor desc;
+  init_descriptor(desc);
+  LatencyModifier modifier(20);
+  modifier.init(desc);
+
+  int last = 0;
+  for(int n = 0; n < 5000; ++n)
+  {
+    // 10 messages per msec
+    ControllerMessage msg = make_msg(n);
+    modifier.update(100, msg, desc);
+
+    const int out = msg.get_abs(0);
+    check(out >= last, "early-release-order", n, out, last);
+    check(out >= n - 200, "early-release-late", n, out, n - 200);
+    check(out <= n, "early-release-future", n, out, n);
+    last = out;
+  }
+
+  check(last > 5000 - 200, "early-release-early", 0, last, 5000 - 200);
+}
+
+} // namespace
+
+int main()
+{
+  test_priming();
+  test_latency_zero();
+  test_wraparound();
+  test_early_release();
+
+  std::cout << "errors: " << errors << std::endl;
+
+  return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* EOF */
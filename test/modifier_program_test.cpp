@@ -0,0 +1,136 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <iostream>
+#include <stdlib.h>
+
+#include "controller_message.hpp"
+#include "controller_message_descriptor.hpp"
+#include "modifier_program.hpp"
+
+namespace {
+
+const char* abs_names[] = { "gamepad.x1", "gamepad.y1", "gamepad.x2", "gamepad.y2" };
+const char* key_names[] = { "gamepad.a", "gamepad.b", "gamepad.dpad_up", "gamepad.dpad_down",
+                            "gamepad.dpad_left", "gamepad.dpad_right" };
+
+const char* modifier_specs[][2] = {
+  { "square", "gamepad.x1:gamepad.y1" },
+  { "4wayrest", "gamepad.x2:gamepad.y2" },
+  { "rotate", "gamepad.x1:gamepad.y1:30" },
+  { "rotate", "gamepad.x2:gamepad.y2:-75:1" },
+  { "stickzone", "gamepad.x1:gamepad.y1:gamepad.a:0.25:0.75" },
+  { "stickzone", "gamepad.x2:gamepad.y2:gamepad.b:0.5:1.0" },
+  { "dpad-rotation", "135" },
+};
+
+const int abs_count = sizeof(abs_names) / sizeof(abs_names[0]);
+const int key_count = sizeof(key_names) / sizeof(key_names[0]);
+const int modifier_count = sizeof(modifier_specs) / sizeof(modifier_specs[0]);
+
+void init_descriptor(ControllerMessageDescriptor& desc)
+{
+  for(int i = 0; i < abs_count; ++i)
+  {
+    desc.abs().put(AbsName(abs_names[i]));
+  }
+
+  for(int i = 0; i < key_count; ++i)
+  {
+    desc.key().put(KeyName(key_names[i]));
+  }
+}
+
+void init_modifier(std::vector<ModifierPtr>& modifier, ControllerMessageDescriptor& desc)
+{
+  for(int i = 0; i < modifier_count; ++i)
+  {
+    modifier.push_back(ModifierPtr(Modifier::from_string(modifier_specs[i][0], modifier_specs[i][1])));
+    modifier.back()->init(desc);
+  }
+}
+
+} // namespace
+
+int main()
+{
+  ControllerMessageDescriptor virtual_desc;
+  ControllerMessageDescriptor program_desc;
+  init_descriptor(virtual_desc);
+  init_descriptor(program_desc);
+
+  std::vector<ModifierPtr> virtual_modifier;
+  std::vector<ModifierPtr> program_modifier;
+  init_modifier(virtual_modifier, virtual_desc);
+  init_modifier(program_modifier, program_desc);
+
+  ModifierProgram program;
+  program.compile(program_modifier);
+  std::cout << "ops: " << program.size() << ", inline: " << program.get_inline_count() << std::endl;
+
+  srand(0);
+
+  int errors = 0;
+  for(int n = 0; n < 10000; ++n)
+  {
+    ControllerMessage msg;
+    for(int i = 0; i < abs_count; ++i)
+    {
+      msg.set_abs(i, rand() % 65536 - 32768, -32768, 32767);
+    }
+    for(int i = 0; i < key_count; ++i)
+    {
+      msg.set_key(i, rand() % 2);
+    }
+
+    ControllerMessage virtual_msg = msg;
+    ControllerMessage program_msg = msg;
+
+    for(std::vector<ModifierPtr>::iterator i = virtual_modifier.begin(); i != virtual_modifier.end(); ++i)
+    {
+      (*i)->update(0, virtual_msg, virtual_desc);
+    }
+    program.run(0, program_msg, program_desc);
+
+    for(int i = 0; i < virtual_desc.get_abs_count(); ++i)
+    {
+      if (virtual_msg.get_abs(i) != program_msg.get_abs(i))
+      {
+        std::cout << n << ": abs " << i << " mismatch: "
+                  << virtual_msg.get_abs(i) << " != " << program_msg.get_abs(i) << std::endl;
+        errors += 1;
+      }
+    }
+
+    for(int i = 0; i < virtual_desc.get_key_count(); ++i)
+    {
+      if (virtual_msg.get_key(i) != program_msg.get_key(i))
+      {
+        std::cout << n << ": key " << i << " mismatch" << std::endl;
+        errors += 1;
+      }
+    }
+  }
+
+  std::cout << "errors: " << errors << std::endl;
+
+  return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* EOF */
@@ -0,0 +1,255 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** Measures the cost of Controller::parse() for every controller that
+    can be created without a device, over a few synthetic report
+    corpora. Run with an optional iteration count:
+
+      test/parse_benchmark [ITERATIONS]
+*/
+
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+#include <new>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+#include "controller/usb_controller.hpp"
+#include "controller_factory.hpp"
+#include "controller_message.hpp"
+#include "controller_message_descriptor.hpp"
+#include "options.hpp"
+#include "report_parser.hpp"
+#include "xpad_device.hpp"
+
+namespace {
+
+unsigned long g_allocations = 0;
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  g_allocations += 1;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](std::size_t size)
+{
+  g_allocations += 1;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p)
+{
+  free(p);
+}
+
+void operator delete[](void* p)
+{
+  free(p);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void* p, std::size_t)
+{
+  free(p);
+}
+
+void operator delete[](void* p, std::size_t)
+{
+  free(p);
+}
+#endif
+
+namespace {
+
+/** Where the interesting parts of a controllers report are */
+struct ReportSpec
+{
+  GamepadType type;
+  const char* name;
+  int len;
+  int header_len;
+  uint8_t header[8];
+  int button_begin;
+  int button_end;
+  int axis_begin;
+  int axis_end;
+};
+
+const ReportSpec specs[] = {
+  { GAMEPAD_XBOX,             "xbox",             20, 2, { 0x00, 0x14 },                         2,  4,  4, 20 },
+  { GAMEPAD_XBOX360,          "xbox360",          20, 2, { 0x00, 0x14 },                         2,  4,  4, 14 },
+  { GAMEPAD_XBOX360_WIRELESS, "xbox360-wireless", 29, 6, { 0x00, 0x01, 0x00, 0xf0, 0x00, 0x13 }, 6,  8,  8, 18 },
+  { GAMEPAD_FIRESTORM,        "firestorm",         7, 0, { 0 },                                  0,  2,  2,  7 },
+  { GAMEPAD_FIRESTORM_VSB,    "firestorm-vsb",     6, 0, { 0 },                                  0,  2,  2,  6 },
+  { GAMEPAD_SAITEK_P2500,     "saitek-p2500",      7, 0, { 0 },                                  5,  7,  1,  5 },
+  { GAMEPAD_LOGITECH_F310,    "logitech-f310",    20, 0, { 0 },                                  2,  4,  4, 14 },
+  { GAMEPAD_PLAYSTATION3_USB, "playstation3-usb", 49, 2, { 0x01, 0x00 },                         2,  6,  6, 49 },
+  { GAMEPAD_HAMA_CRUX,        "hama-crux",         8, 0, { 0 },                                  0,  8,  8,  8 }
+};
+
+const int kCorpusSize = 1024;
+
+enum Corpus { kNeutral, kSweep, kMash };
+const char* corpus_names[] = { "neutral", "sweep", "mash" };
+
+/** Builds kCorpusSize reports for \a spec: neutral has everything
+    zero, sweep moves all axes through their range and mash toggles
+    random buttons */
+std::vector<uint8_t> make_corpus(const ReportSpec& spec, Corpus corpus)
+{
+  std::vector<uint8_t> data(spec.len * kCorpusSize);
+  uint32_t seed = 12345;
+
+  for(int i = 0; i < kCorpusSize; ++i)
+  {
+    uint8_t* report = &data[spec.len * i];
+    std::copy(spec.header, spec.header + spec.header_len, report);
+
+    switch(corpus)
+    {
+      case kNeutral:
+        break;
+
+      case kSweep:
+        for(int j = spec.axis_begin; j < spec.axis_end; ++j)
+        {
+          report[j] = static_cast<uint8_t>(i * 7 + j * 37);
+        }
+        break;
+
+      case kMash:
+        for(int j = spec.button_begin; j < spec.button_end; ++j)
+        {
+          seed = seed * 1103515245 + 12345;
+          report[j] = static_cast<uint8_t>(seed >> 16);
+        }
+        break;
+    }
+  }
+
+  return data;
+}
+
+double now_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<double>(ts.tv_sec) * 1e9 + static_cast<double>(ts.tv_nsec);
+}
+
+template<class Parser>
+void run(const std::string& name, Parser& parser, int len, const std::vector<uint8_t>& corpus,
+         const char* corpus_name, int iterations)
+{
+  ControllerMessage msg;
+  int parsed = 0;
+
+  unsigned long allocations = g_allocations;
+  double start = now_ns();
+  for(int iter = 0; iter < iterations; ++iter)
+  {
+    for(int i = 0; i < kCorpusSize; ++i)
+    {
+      parsed += parser.parse(&corpus[len * i], len, &msg);
+    }
+  }
+  double total = now_ns() - start;
+  allocations = g_allocations - allocations;
+
+  const double reports = static_cast<double>(iterations) * kCorpusSize;
+  std::cout << boost::format("%-24s %-8s %10.1f %14.2f %8s")
+    % name % corpus_name
+    % (total / reports)
+    % (static_cast<double>(allocations) / reports)
+    % (parsed == iterations * kCorpusSize ? "" : "rejected")
+            << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  int iterations = 200;
+  if (argc > 1)
+  {
+    iterations = boost::lexical_cast<int>(argv[1]);
+  }
+
+  Options opts;
+
+  std::cout << boost::format("%-24s %-8s %10s %14s") % "controller" % "corpus" % "ns/report" % "allocs/report"
+            << std::endl;
+
+  for(size_t i = 0; i < sizeof(specs) / sizeof(specs[0]); ++i)
+  {
+    const ReportSpec& spec = specs[i];
+    XPadDevice dev_type = { spec.type, 0, 0, spec.name };
+
+    // controllers without a device only parse, see USBController
+    boost::shared_ptr<USBController> controller
+      = boost::dynamic_pointer_cast<USBController>(ControllerFactory::create(dev_type, NULL, opts));
+
+    for(int c = 0; c < 3; ++c)
+    {
+      std::vector<uint8_t> corpus = make_corpus(spec, static_cast<Corpus>(c));
+      run(spec.name, *controller, spec.len, corpus, corpus_names[c], iterations);
+    }
+  }
+
+  // the table driven parser, with the layout of the saitek example
+  {
+    const char* layout_spec[][2] = {
+      { "xbox.x1", "1:s8:-32768:32767" }, { "xbox.y1", "2:s8:-32768:32767" },
+      { "xbox.x2", "3:s8:-32768:32767" }, { "xbox.y2", "4:s8:-32768:32767" },
+      { "xbox.a",  "5.0" }, { "xbox.b",  "5.1" }, { "xbox.x",  "5.2" }, { "xbox.y",  "5.3" },
+      { "xbox.lb", "5.4" }, { "xbox.lt", "5.5" }, { "xbox.rb", "5.6" }, { "xbox.rt", "5.7" },
+      { "xbox.thumb_l", "6.0" }, { "xbox.thumb_r", "6.1" },
+      { "xbox.start", "6.2" }, { "xbox.back", "6.3" }, { "xbox.dpad", "6.4:hat" }
+    };
+
+    std::vector<ReportField> layout;
+    for(size_t i = 0; i < sizeof(layout_spec) / sizeof(layout_spec[0]); ++i)
+    {
+      layout.push_back(ReportField::from_string(layout_spec[i][0], layout_spec[i][1]));
+    }
+
+    ControllerMessageDescriptor desc;
+    ReportParser parser(layout, desc);
+
+    const ReportSpec& spec = specs[5]; // saitek-p2500
+    for(int c = 0; c < 3; ++c)
+    {
+      std::vector<uint8_t> corpus = make_corpus(spec, static_cast<Corpus>(c));
+      run("report-parser", parser, spec.len, corpus, corpus_names[c], iterations);
+    }
+  }
+
+  return 0;
+}
+
+/* EOF */
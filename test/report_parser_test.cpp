@@ -0,0 +1,96 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <iostream>
+
+#include "controller_message.hpp"
+#include "controller_message_descriptor.hpp"
+#include "report_parser.hpp"
+
+namespace {
+
+int errors = 0;
+
+void expect(const char* what, int value, int expected)
+{
+  if (value != expected)
+  {
+    std::cout << what << ": got " << value << ", expected " << expected << std::endl;
+    errors += 1;
+  }
+}
+
+} // namespace
+
+int main()
+{
+  std::vector<ReportField> layout;
+  layout.push_back(ReportField::from_string("xbox.a",     "0.0"));
+  layout.push_back(ReportField::from_string("xbox.b",     "0.7"));
+  layout.push_back(ReportField::from_string("xbox.dpad",  "0.2:hat"));
+  layout.push_back(ReportField::from_string("xbox.x1",    "1:s8"));
+  layout.push_back(ReportField::from_string("xbox.y1",    "1:s8:32767:-32768"));
+  layout.push_back(ReportField::from_string("xbox.lt",    "2:u8"));
+  layout.push_back(ReportField::from_string("xbox.x2",    "3:s16le"));
+  layout.push_back(ReportField::from_string("xbox.y2",    "3:u16be"));
+  layout.push_back(ReportField::from_string("xbox.rt",    "5.4:s12"));
+  layout.push_back(ReportField::from_string("xbox.black", "7:s32be"));
+
+  ControllerMessageDescriptor desc;
+  ReportParser parser(layout, desc);
+
+  expect("min length", parser.get_min_length(), 11);
+
+  const uint8_t data[] = { 0x8d, 0x80, 0xfe, 0x34, 0x12, 0x50, 0xfa, 0xff, 0xff, 0xff, 0xfe };
+  ControllerMessage msg;
+
+  expect("short report", parser.parse(data, sizeof(data) - 1, &msg), false);
+  expect("parse", parser.parse(data, sizeof(data), &msg), true);
+
+  expect("xbox.a", msg.get_key(desc.key().get(KeyName("xbox.a"))), 1);
+  expect("xbox.b", msg.get_key(desc.key().get(KeyName("xbox.b"))), 1);
+
+  // 0x8d >> 2 & 0xf == 3, down-right
+  expect("dpad up",    msg.get_key(desc.key().get(KeyName("xbox.dpad_up"))),    0);
+  expect("dpad down",  msg.get_key(desc.key().get(KeyName("xbox.dpad_down"))),  1);
+  expect("dpad left",  msg.get_key(desc.key().get(KeyName("xbox.dpad_left"))),  0);
+  expect("dpad right", msg.get_key(desc.key().get(KeyName("xbox.dpad_right"))), 1);
+
+  int x1 = desc.abs().get(AbsName("xbox.x1"));
+  expect("xbox.x1",     msg.get_abs(x1), -128);
+  expect("xbox.x1 min", msg.get_abs_min(x1), -128);
+  expect("xbox.x1 max", msg.get_abs_max(x1), 127);
+
+  int y1 = desc.abs().get(AbsName("xbox.y1"));
+  expect("xbox.y1",     msg.get_abs(y1), 32767);
+  expect("xbox.y1 min", msg.get_abs_min(y1), -32768);
+
+  expect("xbox.lt",    msg.get_abs(desc.abs().get(AbsName("xbox.lt"))), 254);
+  expect("xbox.x2",    msg.get_abs(desc.abs().get(AbsName("xbox.x2"))), 0x1234);
+  expect("xbox.y2",    msg.get_abs(desc.abs().get(AbsName("xbox.y2"))), 0x3412);
+  // bits 4-15 of 0xfa50 are 0xfa5, sign extended
+  expect("xbox.rt",    msg.get_abs(desc.abs().get(AbsName("xbox.rt"))), 0xfa5 - 0x1000);
+  expect("xbox.black", msg.get_abs(desc.abs().get(AbsName("xbox.black"))), -2);
+
+  std::cout << errors << " errors" << std::endl;
+
+  return errors == 0 ? 0 : 1;
+}
+
+/* EOF */
@@ -0,0 +1,134 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** Measures table_gather() against a plain lookup loop for batches of
+    the size AxisMap::send() produces. Run with an optional iteration
+    count:
+
+      test/table_gather_benchmark [ITERATIONS]
+*/
+
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iostream>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+#include "table_gather.hpp"
+
+namespace {
+
+const int kBatches = 256;
+
+double now_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<double>(ts.tv_sec) * 1e9 + static_cast<double>(ts.tv_nsec);
+}
+
+void loop_gather(const int* base, const int* offset, const int* raw, const int* min,
+                 int* out, int count)
+{
+  for(int i = 0; i < count; ++i)
+  {
+    out[i] = offset[i] < 0 ? raw[i] : base[offset[i] + raw[i] - min[i]];
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  int iterations = 2000;
+  if (argc > 1)
+  {
+    iterations = boost::lexical_cast<int>(argv[1]);
+  }
+
+  srand(0);
+
+  // a stick and a trigger table, as for a xbox360 pad with filters on
+  // both
+  const int table_min[2] = { -32768, 0 };
+  const int table_max[2] = { 32767, 255 };
+  int table_offset[2];
+  std::vector<int> tables;
+  for(int t = 0; t < 2; ++t)
+  {
+    table_offset[t] = static_cast<int>(tables.size());
+    for(int v = table_min[t]; v <= table_max[t]; ++v)
+    {
+      tables.push_back(rand());
+    }
+  }
+
+  std::cout << boost::format("%-8s %14s %14s") % "events" % "loop ns" % "gather ns" << std::endl;
+
+  const int counts[] = { 6, 8, 16, 32 };
+  for(int c = 0; c < static_cast<int>(sizeof(counts) / sizeof(counts[0])); ++c)
+  {
+    const int count = counts[c];
+    std::vector<int> offset(count * kBatches);
+    std::vector<int> raw(count * kBatches);
+    std::vector<int> min(count * kBatches);
+    std::vector<int> out(count * kBatches);
+
+    for(int i = 0; i < count * kBatches; ++i)
+    {
+      const int t = (i % 6 < 4) ? 0 : 1;
+      offset[i] = table_offset[t];
+      min[i]    = table_min[t];
+      raw[i]    = table_min[t] + rand() % (table_max[t] - table_min[t] + 1);
+    }
+
+    double times[2];
+    int checksum[2] = { 0, 0 };
+    for(int impl = 0; impl < 2; ++impl)
+    {
+      double start = now_ns();
+      for(int iter = 0; iter < iterations; ++iter)
+      {
+        for(int b = 0; b < kBatches; ++b)
+        {
+          const int k = b * count;
+          if (impl == 0)
+          {
+            loop_gather(&tables[0], &offset[k], &raw[k], &min[k], &out[k], count);
+          }
+          else
+          {
+            table_gather(&tables[0], &offset[k], &raw[k], &min[k], &out[k], count);
+          }
+        }
+        checksum[impl] += out[iter % out.size()];
+      }
+      times[impl] = (now_ns() - start) / (static_cast<double>(iterations) * kBatches);
+    }
+
+    std::cout << boost::format("%-8d %14.1f %14.1f %s")
+      % count % times[0] % times[1] % (checksum[0] == checksum[1] ? "" : "mismatch")
+              << std::endl;
+  }
+
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,100 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+
+#include "table_gather.hpp"
+
+int main()
+{
+  int errors = 0;
+  int runs = 0;
+
+  srand(0);
+
+  // a few tables with different ranges back to back, values far
+  // from their index so that a lookup in the wrong table shows
+  const int table_count = 3;
+  const int table_min[table_count] = { -32768, 0, -128 };
+  const int table_max[table_count] = { 32767, 255, 127 };
+  int table_offset[table_count];
+  std::vector<int> tables;
+  for(int t = 0; t < table_count; ++t)
+  {
+    table_offset[t] = static_cast<int>(tables.size());
+    for(int v = table_min[t]; v <= table_max[t]; ++v)
+    {
+      tables.push_back(rand());
+    }
+  }
+
+  // cover every length around the vector width, compare against a
+  // plain loop
+  for(int count = 0; count <= 37; ++count)
+  {
+    for(int rep = 0; rep < 20; ++rep)
+    {
+      int offset[37];
+      int raw[37];
+      int min[37];
+      int out[37];
+      int expected[37];
+
+      for(int i = 0; i < count; ++i)
+      {
+        const int t = rand() % (table_count + 1);
+        if (t == table_count)
+        {
+          offset[i]   = -1;
+          raw[i]      = rand() - RAND_MAX / 2;
+          min[i]      = 0;
+          expected[i] = raw[i];
+        }
+        else
+        {
+          offset[i]   = table_offset[t];
+          min[i]      = table_min[t];
+          raw[i]      = table_min[t] + rand() % (table_max[t] - table_min[t] + 1);
+          expected[i] = tables[offset[i] + raw[i] - min[i]];
+        }
+      }
+
+      table_gather(&tables[0], offset, raw, min, out, count);
+
+      runs += 1;
+      for(int i = 0; i < count; ++i)
+      {
+        if (out[i] != expected[i])
+        {
+          std::cout << "mismatch: count=" << count << " i=" << i << std::endl;
+          errors += 1;
+          break;
+        }
+      }
+    }
+  }
+
+  std::cout << runs << " runs, " << errors << " errors" << std::endl;
+
+  return errors == 0 ? 0 : 1;
+}
+
+/* EOF */
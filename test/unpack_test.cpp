@@ -31,6 +31,10 @@ int main(int argc, char** argv)
   std::cout << "uint32be: " << unpack::uint32be(data) << std::endl;
   std::cout << "uint32le: " << unpack::uint32le(data) << std::endl;
 
+  int16_t values[2];
+  unpack::int16le_array(data, values, 2);
+  std::cout << "int16le_array: " << values[0] << " " << values[1] << std::endl;
+
   uint8_t data2[] = { 0, 128, 255 };
   std::cout << std::dec;
   std::cout << "u8_to_s16: " << 0 << " " << unpack::u8_to_s16(data2[0]) << std::endl;
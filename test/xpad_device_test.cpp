@@ -0,0 +1,68 @@
+/*
+**  Xbox360 USB Gamepad Userspace Driver
+**  Copyright (C) 2011 Ingo Ruhnke <grumbel@gmx.de>
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <boost/format.hpp>
+
+#include "xpad_device.hpp"
+
+int main()
+{
+  int errors = 0;
+
+  // every entry must be found and ids that are listed multiple times
+  // must resolve to their first entry
+  for(int i = 0; i < xpad_devices_count; ++i)
+  {
+    int first = i;
+    for(int j = 0; j < i; ++j)
+    {
+      if (xpad_devices[j].idVendor  == xpad_devices[i].idVendor &&
+          xpad_devices[j].idProduct == xpad_devices[i].idProduct)
+      {
+        first = j;
+        break;
+      }
+    }
+
+    XPadDevice dev_type;
+    if (!find_xpad_device(xpad_devices[i].idVendor, xpad_devices[i].idProduct, &dev_type) ||
+        dev_type.name != xpad_devices[first].name)
+    {
+      std::cout << boost::format("lookup failed: 0x%04x 0x%04x %s")
+        % int(xpad_devices[i].idVendor)
+        % int(xpad_devices[i].idProduct)
+        % xpad_devices[i].name << std::endl;
+      errors += 1;
+    }
+  }
+
+  XPadDevice dev_type;
+  if (find_xpad_device(0x0000, 0x0000, &dev_type) ||
+      find_xpad_device(0xffff, 0xffff, &dev_type))
+  {
+    std::cout << "lookup of unknown device succeeded" << std::endl;
+    errors += 1;
+  }
+
+  std::cout << xpad_devices_count << " devices, " << errors << " errors" << std::endl;
+
+  return errors == 0 ? 0 : 1;
+}
+
+/* EOF */